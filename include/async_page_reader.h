@@ -0,0 +1,102 @@
+#ifndef ASYNC_PAGE_READER_H
+#define ASYNC_PAGE_READER_H
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include "page_file.h"
+
+// A finished read. data points at the page and stays valid until the
+// next call to wait().
+struct PageReadCompletion {
+    uint64_t tag;
+    char* data;
+};
+
+// Keeps up to queue_depth page reads of a PageFile in flight through
+// io_uring, talking to the kernel with the raw syscalls (no liburing).
+// read() only queues a request; wait() submits everything queued in one
+// io_uring_enter and returns whatever has completed, so a caller that
+// keeps the queue full gets as many outstanding reads as the device
+// will take instead of one pread at a time.
+//
+// Where io_uring is unavailable (old kernel, seccomp, disabled by
+// sysctl) reads fall back to synchronous pread inside read(), which
+// isAsync() reports; callers work unchanged, with getQueueDepth() at 1.
+class AsyncPageReader {
+private:
+    struct Slot {
+        PageId page_id;
+        uint64_t tag;
+        std::chrono::steady_clock::time_point issued;
+    };
+
+    PageFile& file;
+    unsigned queue_depth;
+    bool async;
+
+    // io_uring state: the three shared rings and their mapped sizes
+    int ring_fd;
+    void* sq_ring;
+    void* cq_ring;
+    void* sqe_memory;
+    size_t sq_ring_bytes;
+    size_t cq_ring_bytes;
+    size_t sqe_bytes;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    void* cqes;
+
+    // Twice queue_depth page buffers: the reads in flight plus the
+    // completions handed out by the last wait()
+    char* buffers;
+    std::vector<Slot> slots;
+    std::vector<unsigned> free_slots;
+    std::vector<unsigned> delivered;   // Slots returned by the last wait()
+    std::vector<unsigned> ready;       // pread fallback: completed in read()
+    unsigned in_flight;
+    unsigned unsubmitted;
+
+    long long reads;
+    long long submits;            // io_uring_enter calls
+    double total_latency_us;      // Queue to reap, summed over all reads
+    double max_latency_us;
+
+    bool setupRing();
+    void closeRing();
+    char* slotData(unsigned slot) { return buffers + static_cast<size_t>(slot) * file.getPageSize(); }
+    void complete(unsigned slot, std::vector<PageReadCompletion>& completed);
+
+public:
+    AsyncPageReader(PageFile& pageFile, unsigned queueDepth);
+    ~AsyncPageReader();
+
+    AsyncPageReader(const AsyncPageReader&) = delete;
+    AsyncPageReader& operator=(const AsyncPageReader&) = delete;
+
+    // Queues a read of page id; needs inFlight() < getQueueDepth()
+    void read(PageId id, uint64_t tag);
+
+    // Submits the queued reads and blocks until at least one read has
+    // completed (none if nothing is in flight). Completions are appended.
+    void wait(std::vector<PageReadCompletion>& completed);
+
+    bool isAsync() const { return async; }
+    unsigned getQueueDepth() const { return queue_depth; }
+    unsigned inFlight() const { return in_flight; }
+    bool full() const { return in_flight == queue_depth; }
+
+    long long getReads() const { return reads; }
+    long long getSubmits() const { return submits; }
+    double getMeanLatencyUs() const { return reads == 0 ? 0.0 : total_latency_us / reads; }
+    double getMaxLatencyUs() const { return max_latency_us; }
+    void resetStats() { reads = 0; submits = 0; total_latency_us = 0.0; max_latency_us = 0.0; }
+};
+
+#endif
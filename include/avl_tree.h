@@ -0,0 +1,60 @@
+#ifndef AVL_TREE_H
+#define AVL_TREE_H
+
+#include <vector>
+#include <memory>
+#include "node_allocator.h"
+
+// AVL tree node. height is the node's subtree height (a leaf is 1).
+template <typename T>
+struct AVLNode {
+    T key;
+    AVLNode* left;
+    AVLNode* right;
+    int height;
+
+    AVLNode(T k) : key(k), left(nullptr), right(nullptr), height(1) {}
+};
+
+// Height-balanced binary search tree: sibling subtrees differ in height by
+// at most one, so height stays below 1.44 log2(n + 2). Same set semantics
+// as BST (duplicates are ignored). Insert, search and teardown are
+// iterative; insert records its descent path and retraces it bottom-up.
+template <typename T>
+class AVLTree {
+private:
+    AVLNode<T>* root;
+    size_t num_keys;
+    std::unique_ptr<NodeAllocator> allocator;
+
+    // Enough for any tree that fits in memory (AVL height < 1.44 log2 n)
+    static const int MAX_HEIGHT = 96;
+
+    AVLNode<T>* createNode(T key);
+    void destroyNode(AVLNode<T>* node);
+    void deleteTree();
+
+    static int heightOf(AVLNode<T>* node) { return node == nullptr ? 0 : node->height; }
+    static void updateHeight(AVLNode<T>* node);
+    static AVLNode<T>* rotateLeft(AVLNode<T>* node);
+    static AVLNode<T>* rotateRight(AVLNode<T>* node);
+    static AVLNode<T>* rebalance(AVLNode<T>* node);
+
+public:
+    explicit AVLTree(NodeAllocatorKind allocatorKind = NodeAllocatorKind::HEAP);
+    ~AVLTree();
+
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    void insert(T key);
+    bool search(T key) const;
+    std::vector<T> rangeScan(T lo, T hi) const;    // All keys in [lo, hi], in order
+
+    int getHeight() const { return heightOf(root); }
+    size_t size() const { return num_keys; }
+    AVLNode<T>* getRoot() { return root; }
+    const NodeAllocator& getAllocator() const { return *allocator; }
+};
+
+#endif
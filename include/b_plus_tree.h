@@ -0,0 +1,111 @@
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <vector>
+#include <iostream>
+
+
+template <typename T>
+class BPlusTree;
+
+// B+tree node. Leaves hold every key and are chained left-to-right;
+// internal nodes hold only separators used to route the descent.
+template <typename T>
+class BPlusTreeNode{
+	public:
+	std::vector<T> keys;                    // Leaf: records, internal: separators
+	std::vector<BPlusTreeNode*> children;   // Internal nodes only
+	BPlusTreeNode* next;                    // Next leaf in key order
+	bool is_leaf;
+
+	void printTree(int level = 0);
+
+	BPlusTreeNode(int degree, bool leaf);
+	~BPlusTreeNode();
+	friend class BPlusTree<T>;
+};
+
+
+// Forward iterator: walks the leaf chain, so a scan never revisits
+// internal nodes after the initial descent.
+template <typename T>
+class BPlusTreeIterator{
+	private:
+		BPlusTreeNode<T>* leaf;
+		size_t index;
+
+		// Skip past the end of (possibly empty) leaves
+		void settle(){
+			while (leaf != nullptr && index >= leaf->keys.size()) {
+				leaf = leaf->next;
+				index = 0;
+			}
+		}
+
+		friend class BPlusTree<T>;
+
+	public:
+		BPlusTreeIterator() : leaf(nullptr), index(0) {}
+		BPlusTreeIterator(BPlusTreeNode<T>* node, size_t i) : leaf(node), index(i) { settle(); }
+
+		const T& operator*() const { return leaf->keys[index]; }
+
+		BPlusTreeIterator& operator++(){
+			index++;
+			settle();
+			return *this;
+		}
+
+		bool operator==(const BPlusTreeIterator& other) const {
+			return leaf == other.leaf && (leaf == nullptr || index == other.index);
+		}
+		bool operator!=(const BPlusTreeIterator& other) const { return !(*this == other); }
+};
+
+
+template<typename T>
+class BPlusTree{
+	private:
+		BPlusTreeNode<T>* root;
+		int min_degree;
+
+		void splitChild(BPlusTreeNode<T>* parent, int index, BPlusTreeNode<T>* child);
+		BPlusTreeNode<T>* findLeaf(T key);
+
+	public:
+		BPlusTree(int degree){
+			root = nullptr;
+			min_degree = degree;
+		}
+		~BPlusTree();
+
+		typedef BPlusTreeIterator<T> iterator;
+
+		void insert(T key);
+		bool search(T key);
+		void traverse();
+		void printTree();
+
+		// Ordered access
+		iterator begin();
+		iterator end() { return iterator(); }
+		iterator lowerBound(T key);              // First key >= key
+		std::vector<T> rangeScan(T lo, T hi);    // All keys in [lo, hi], in order
+
+		BPlusTreeNode<T>* getRoot() {return root;}
+};
+
+
+// Helper function to calculate B+tree height (all leaves are at the same depth)
+template <typename T>
+int calculateBPlusTreeHeight(BPlusTreeNode<T>* node) {
+    int height = 0;
+    while (node != nullptr) {
+        height++;
+        node = node->is_leaf ? nullptr : node->children[0];
+    }
+    return height;
+}
+
+
+#endif
@@ -5,11 +5,33 @@
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include "node_search.h"
 
 
 template <typename T>
 class BTree;
 
+// How BTree::remove keeps nodes at or above the (min_degree-1) minimum
+enum class DeleteMode {
+	EAGER,  // Borrow from a sibling or merge on the way down (CLRS)
+	LAZY    // Let leaves run underfull; rebuild once enough deletes pile up
+};
+
+// Node size of a full BtreeNode: the key array (2t-1 keys) and the child
+// pointer array (2t), the two allocations a search walks through
+inline size_t btreeNodeBytes(size_t keySize, int degree){
+	return (2 * degree - 1) * keySize + 2 * degree * sizeof(void*);
+}
+
+// Largest min_degree whose full node fits in nodeBytes, never below 2.
+// Picks the degree from the key size and a target node size (a cache
+// line multiple in memory, the page size for storage) instead of a guess.
+inline int btreeDegreeForNodeBytes(size_t keySize, size_t nodeBytes){
+	int degree = static_cast<int>((nodeBytes + keySize) / (2 * (keySize + sizeof(void*))));
+	return degree < 2 ? 2 : degree;
+}
+
 template <typename T>
 class BtreeNode{
 	public:
@@ -20,11 +42,23 @@ class BtreeNode{
 	
 
 
-	void insertNonFull(T key);
+	void insertNonFull(T key, NodeSearchMode mode = NodeSearchMode::LINEAR);
 	void splitChild(int index, BtreeNode* child);
+
+	// Deletion (CLRS). remove() expects this node to hold at least
+	// min_degree keys unless it is the root.
+	bool remove(T key, NodeSearchMode mode = NodeSearchMode::LINEAR);
+	void removeFromInternal(size_t index, NodeSearchMode mode);
+	T maxKey();
+	T minKey();
+	void fill(size_t index);
+	void borrowFromPrev(size_t index);
+	void borrowFromNext(size_t index);
+	void merge(size_t index);
+
 	void traverse();
 	void printTree(int level = 0);  // Visualize tree structure
-	BtreeNode* search(T key);
+	BtreeNode* search(T key, NodeSearchMode mode = NodeSearchMode::LINEAR);
 
 
 	BtreeNode(int degree, bool leaf);
@@ -35,25 +69,143 @@ class BtreeNode{
 
 
 
+// Forward iterator over a B-tree in key order. Keeps the root-to-node
+// path on a stack, so advancing never re-descends from the root.
+template <typename T>
+class BTreeIterator{
+	private:
+		struct Frame {
+			BtreeNode<T>* node;
+			size_t index;  // Next key of node to yield (after child[index] is done)
+		};
+		std::vector<Frame> path;
+
+		// Push node and its leftmost descendants
+		void descendLeftmost(BtreeNode<T>* node){
+			while (node != nullptr) {
+				path.push_back(Frame{node, 0});
+				node = node->is_leaf ? nullptr : node->children[0];
+			}
+		}
+
+		// Pop frames whose keys are exhausted
+		void settle(){
+			while (!path.empty() && path.back().index >= path.back().node->keys.size()) {
+				path.pop_back();
+			}
+		}
+
+		friend class BTree<T>;
+
+	public:
+		BTreeIterator() {}
+
+		const T& operator*() const { return path.back().node->keys[path.back().index]; }
+
+		BTreeIterator& operator++(){
+			Frame& top = path.back();
+			top.index++;
+			if (!top.node->is_leaf) {
+				descendLeftmost(top.node->children[top.index]);
+			}
+			settle();
+			return *this;
+		}
+
+		bool operator==(const BTreeIterator& other) const {
+			if (path.empty() || other.path.empty()) {
+				return path.empty() && other.path.empty();
+			}
+			return path.back().node == other.path.back().node &&
+			       path.back().index == other.path.back().index;
+		}
+		bool operator!=(const BTreeIterator& other) const { return !(*this == other); }
+};
+
+
 template<typename T>
 class BTree{
 	private: 
 		BtreeNode<T>* root;
 		int min_degree;
+		NodeSearchMode search_mode;
+		size_t num_keys;
+
+		DeleteMode delete_mode;
+		double rebalance_ratio;   // LAZY: rebuild after this fraction of size() deletes
+		size_t lazy_deletes;      // LAZY: deletes since the last rebuild
+
+		void bulkLoadSorted(const std::vector<T>& sorted, double fill_factor);
+		bool removeLazy(T key);
+		void shrinkRoot();
+		size_t searchBatchNode(BtreeNode<T>* node, const T* probes, const size_t* order,
+		                       size_t count, std::vector<bool>& found);
 	public:
-		BTree(int degree){
+		BTree(int degree, NodeSearchMode mode = NodeSearchMode::LINEAR){
 			root = nullptr;
 			min_degree = degree;
+			search_mode = mode;
+			num_keys = 0;
+			delete_mode = DeleteMode::EAGER;
+			rebalance_ratio = 0.25;
+			lazy_deletes = 0;
 		}
 		~BTree();
 
+		typedef BTreeIterator<T> iterator;
 
 		void insert(T key);
+		bool remove(T key);   // Removes one occurrence; false if key is absent
 	    	void printTree();  // Print visual tree structure
 		bool search(T key);
 		void traverse();
 
+		// Look up probes[0..count) in one merged descent: probes are sorted
+		// (skipped when presorted) and each node is visited at most once per
+		// batch, with its probes split among the children it routes them to.
+		// found[i] is set for probes[i]. Returns the number of nodes visited.
+		size_t searchBatch(const T* probes, size_t count, std::vector<bool>& found,
+		                   bool presorted = false);
+
+		// Build the tree bottom-up from [first, last) in one pass, replacing
+		// any existing contents. Input that is not already sorted is sorted
+		// first. fill_factor (0.5 - 1.0) is the target occupancy of each node.
+		template <typename Iterator>
+		void bulkLoad(Iterator first, Iterator last, double fill_factor = 1.0){
+			std::vector<T> sorted(first, last);
+			if (!std::is_sorted(sorted.begin(), sorted.end())) {
+				std::sort(sorted.begin(), sorted.end());
+			}
+			bulkLoadSorted(sorted, fill_factor);
+		}
+
+		// Ordered access
+		iterator begin();
+		iterator end() { return iterator(); }
+		iterator lowerBound(T key);              // First key >= key
+		std::vector<T> rangeScan(T lo, T hi);    // All keys in [lo, hi], in order
+
+		// In-node key search strategy (linear, branchless binary, SIMD)
+		void setSearchMode(NodeSearchMode mode) {search_mode = mode;}
+		NodeSearchMode getSearchMode() const {return search_mode;}
+
+		// Deletion strategy. In LAZY mode the tree is rebuilt once the
+		// deletes since the last rebuild exceed ratio * size().
+		void setDeleteMode(DeleteMode mode, double ratio = 0.25) {
+			delete_mode = mode;
+			rebalance_ratio = ratio;
+		}
+		DeleteMode getDeleteMode() const {return delete_mode;}
+		void rebalance(double fill_factor = 1.0);  // Rebuild from the current keys
+
+		size_t size() const {return num_keys;}
+		double fillFactor();  // Keys stored / key slots across all nodes
+
 		BtreeNode<T>* getRoot() {return root;}
+		int getMinDegree() const {return min_degree;}
+
+		static int degreeForNodeBytes(size_t nodeBytes) {return btreeDegreeForNodeBytes(sizeof(T), nodeBytes);}
+		static size_t nodeBytes(int degree) {return btreeNodeBytes(sizeof(T), degree);}
 
 };
 
@@ -10,18 +10,29 @@
 #include <algorithm>
 #include <random>        // ✅ ADD THIS LINE
 #include <thread> 
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include "latency_histogram.h"
+#include "perf_counters.h"
+#include "instrumentation.h"
 
 // Metrics structure
 struct OperationMetrics {
     long long insert_time_us;      // Insert time in microseconds
     long long search_time_us;      // Search time in microseconds
-    long long range_query_time_us; // Range query time
+    long long range_query_time_us; // Range scan over 100 keys
+    long long range_scan_10k_time_us;  // Range scan over 10K keys
+    long long range_scan_full_time_us; // Range scan over the whole tree
     int tree_height;               // Height of tree
     size_t memory_nodes;           // Number of nodes
     size_t memory_bytes;           // Estimated memory usage
     int disk_reads;                // Simulated disk reads
     int disk_writes;               // Simulated disk writes
     double avg_keys_per_node;      // Average keys per node
+    int cache_hits;                // Buffer pool hits (file-backed trees)
+    int cache_misses;              // Buffer pool misses (each one is a page read)
+    int cache_evictions;           // Frames recycled by the eviction policy
 };
 
 // Test scenario types
@@ -120,6 +131,20 @@ public:
             return data[n/2];
         }
     }
+
+    // Half-width of the 95% confidence interval of the mean (Student's t,
+    // since repetition counts are small)
+    static double confidence95(const std::vector<long long>& data) {
+        if (data.size() < 2) return 0;
+        static const double t95[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+        };
+        size_t df = data.size() - 1;
+        double t = df <= 30 ? t95[df - 1] : 1.96;
+        return t * stddev(data) / std::sqrt(static_cast<double>(data.size()));
+    }
 };
 
 // Data generator
@@ -179,8 +204,291 @@ public:
         }
         return data;
     }
+
+    // Unique file paths in a directory tree grown as we go: most files land
+    // in an existing directory and some open a new subdirectory, so keys
+    // share long prefixes like "/var/lib/docker/overlay2/..." the way real
+    // file system names do. Insertion order is random across directories.
+    static std::vector<std::string> pathNames(int count, int seed = 42) {
+        static const char* roots[] = {
+            "/usr/share/doc", "/usr/lib/x86_64-linux-gnu", "/var/lib/docker/overlay2",
+            "/home/alice/projects", "/etc/systemd/system", "/opt/app/releases"
+        };
+        static const char* names[] = {
+            "src", "include", "lib", "build", "config", "cache", "data", "logs",
+            "tmp", "assets", "tests", "docs", "bin", "share", "modules"
+        };
+        static const char* extensions[] = {".txt", ".conf", ".log", ".json", ".so", ".h", ".cpp", ".md"};
+
+        std::mt19937 gen(seed);
+        std::vector<std::string> dirs(roots, roots + sizeof(roots) / sizeof(roots[0]));
+        std::vector<std::string> data;
+        data.reserve(count);
+
+        for (int i = 0; i < count; i++) {
+            std::string dir = dirs[gen() % dirs.size()];
+            if (gen() % 8 == 0) {
+                dir += "/" + std::string(names[gen() % 15]) + std::to_string(gen() % 100);
+                dirs.push_back(dir);
+            }
+            data.push_back(dir + "/file" + std::to_string(i) + extensions[gen() % 8]);
+        }
+        return data;
+    }
+};
+
+// Picks scan bounds over an existing data set
+class RangeWorkload {
+public:
+    // Inclusive bounds covering `width` distinct keys of data, starting a
+    // quarter of the way into the sorted key space (clamped to the data)
+    static std::pair<int, int> bounds(const std::vector<int>& data, size_t width) {
+        std::vector<int> keys = data;
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        if (keys.empty()) return std::make_pair(0, -1);
+
+        if (width > keys.size()) width = keys.size();
+        size_t start = std::min(keys.size() / 4, keys.size() - width);
+        return std::make_pair(keys[start], keys[start + width - 1]);
+    }
+
+    // Inclusive bounds covering every key in data
+    static std::pair<int, int> full(const std::vector<int>& data) {
+        return bounds(data, data.size());
+    }
+};
+
+// === Benchmark harness ===
+//
+// One timing loop for every tree engine and workload. Engines and
+// workloads are registered by name; each case (engine x workload x size)
+// runs warmup passes that are thrown away, then repeated measured passes,
+// each on a fresh tree. Every phase is reported as a distribution over
+// the passes instead of a single timing. A last pass times each insert
+// and lookup on its own, for the tail latencies that totals hide (node
+// splits, root splits, rebalancing).
+
+// min_degree of the B-tree engines in the main matrix, unless the run
+// picks one from a node size (csv_export --node-bytes)
+static const int BENCH_BTREE_DEGREE = 100;
+
+enum class BenchmarkPhase {
+    INSERT,       // All keys into an empty tree
+    SEARCH,       // Every inserted key looked up once
+    RANGE_100,    // Scans, timed per scan (repeated until long enough to time)
+    RANGE_10K,
+    RANGE_FULL
+};
+static const int BENCHMARK_PHASES = 5;
+
+std::string benchmarkPhaseName(BenchmarkPhase phase);
+
+// One phase over all measured passes, in microseconds
+struct TimingSummary {
+    size_t samples;
+    double mean_us;
+    double median_us;
+    double stddev_us;
+    double min_us;
+    double max_us;
+    double ci95_low_us;    // 95% confidence interval of the mean
+    double ci95_high_us;
+};
+
+// Per-operation latency of one phase, in nanoseconds
+struct LatencySummary {
+    uint64_t operations;
+    double mean_ns;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+};
+
+// Hardware counter events per operation of one phase (per key returned
+// for scans), over the measured passes; -1 where the event was not counted
+struct PhaseCounters {
+    double per_op[PERF_EVENTS];
+};
+
+// Exact access counts per key of the insert and search phases, from the
+// counters compiled in with make INSTRUMENT=1 (instrumentation.h); -1 for
+// scans, uninstrumented builds and engines without counters
+struct AccessCounts {
+    double nodes_visited;
+    double key_comparisons;
+    double node_splits;
+    double bytes_moved;
+};
+
+// Tree under test. Each call is a whole phase, so the virtual dispatch is
+// paid once per phase and not once per key. The overloads taking a
+// histogram also time every operation into it.
+class TreeEngine {
+public:
+    virtual ~TreeEngine() {}
+    virtual void insertAll(const std::vector<int>& keys) = 0;
+    virtual size_t searchAll(const std::vector<int>& keys) = 0;   // Keys found
+    virtual void insertAll(const std::vector<int>& keys, LatencyHistogram& latencies) = 0;
+    virtual size_t searchAll(const std::vector<int>& keys, LatencyHistogram& latencies) = 0;
+    virtual size_t rangeScan(int lo, int hi) = 0;                 // Keys returned
+    virtual int height() = 0;
+};
+
+// TreeEngine over any tree with insert, search and rangeScan
+template <typename Tree, typename HeightFn>
+class TreeEngineAdapter : public TreeEngine {
+private:
+    std::unique_ptr<Tree> tree;
+    HeightFn height_fn;
+
+public:
+    TreeEngineAdapter(Tree* t, HeightFn heightFn) : tree(t), height_fn(heightFn) {}
+
+    void insertAll(const std::vector<int>& keys) override {
+        for (int key : keys) {
+            tree->insert(key);
+        }
+    }
+    size_t searchAll(const std::vector<int>& keys) override {
+        size_t found = 0;
+        for (int key : keys) {
+            found += tree->search(key) ? 1 : 0;
+        }
+        return found;
+    }
+
+    // One clock read per operation: each timestamp closes one operation
+    // and opens the next, so record() is charged to the following one
+    void insertAll(const std::vector<int>& keys, LatencyHistogram& latencies) override {
+        auto last = std::chrono::high_resolution_clock::now();
+        for (int key : keys) {
+            tree->insert(key);
+            auto now = std::chrono::high_resolution_clock::now();
+            latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+            last = now;
+        }
+    }
+    size_t searchAll(const std::vector<int>& keys, LatencyHistogram& latencies) override {
+        size_t found = 0;
+        auto last = std::chrono::high_resolution_clock::now();
+        for (int key : keys) {
+            found += tree->search(key) ? 1 : 0;
+            auto now = std::chrono::high_resolution_clock::now();
+            latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+            last = now;
+        }
+        return found;
+    }
+
+    size_t rangeScan(int lo, int hi) override { return tree->rangeScan(lo, hi).size(); }
+    int height() override { return height_fn(*tree); }
 };
 
+typedef std::function<std::unique_ptr<TreeEngine>()> EngineFactory;
+typedef std::function<std::vector<int>(int size)> WorkloadGenerator;
+
+// create() returns a new, empty tree; height(tree) its height after the run
+template <typename Tree, typename CreateFn, typename HeightFn>
+EngineFactory makeEngineFactory(CreateFn create, HeightFn height) {
+    return [create, height]() {
+        return std::unique_ptr<TreeEngine>(new TreeEngineAdapter<Tree, HeightFn>(create(), height));
+    };
+}
+
+struct HarnessConfig {
+    static const int DEFAULT_WARMUP_RUNS = 1;
+    static const int DEFAULT_REPETITIONS = 5;
+    static const int DEFAULT_MIN_REPETITIONS = 3;
+    static const long long DEFAULT_CASE_BUDGET_US = 5000000;
+
+    int warmup_runs;
+    int repetitions;          // Measured passes per case
+    int min_repetitions;      // Floor when the budget cuts repetitions
+    long long case_budget_us; // Rough time limit for the measured passes of one case.
+                              // When a warmup pass alone takes longer, the latency
+                              // pass is the only sample: a run that long is not
+                              // dominated by noise, or by the per-operation timing.
+    bool perf_counters;       // Count hardware events around each measured phase
+
+    HarnessConfig()
+        : warmup_runs(DEFAULT_WARMUP_RUNS), repetitions(DEFAULT_REPETITIONS),
+          min_repetitions(DEFAULT_MIN_REPETITIONS), case_budget_us(DEFAULT_CASE_BUDGET_US),
+          perf_counters(false) {}
+};
+
+struct CaseResult {
+    std::string engine;
+    std::string workload;
+    int num_elements;
+    int tree_height;
+    int repetitions;
+    TimingSummary phases[BENCHMARK_PHASES];
+    LatencySummary insert_latency;   // From one extra pass timing every operation
+    LatencySummary search_latency;
+    PhaseCounters counters[BENCHMARK_PHASES];
+    AccessCounts accesses[BENCHMARK_PHASES];
+
+    const TimingSummary& phase(BenchmarkPhase p) const { return phases[static_cast<int>(p)]; }
+};
+
+class BenchmarkHarness {
+private:
+    HarnessConfig config;
+    std::vector<std::pair<std::string, EngineFactory>> engines;
+    std::vector<std::pair<std::string, WorkloadGenerator>> workloads;
+    std::unique_ptr<PerfCounters> perf;   // Null unless enabled and available
+
+    // Counter totals of each phase, summed over the passes that count
+    struct CounterTotals {
+        double events[BENCHMARK_PHASES][PERF_EVENTS];
+        bool valid[BENCHMARK_PHASES][PERF_EVENTS];
+        double operations[BENCHMARK_PHASES];
+    };
+    void startCounters(CounterTotals* totals);
+    void stopCounters(CounterTotals* totals, BenchmarkPhase phase, double operations);
+
+    // One pass on a fresh tree; adds one sample per phase in nanoseconds.
+    // With histograms, insert and search latencies are recorded per
+    // operation; with totals, hardware counters are added up per phase;
+    // with accessCounts, the insert and search access counters are read.
+    void runPass(const EngineFactory& factory, const std::vector<int>& data,
+                 const std::pair<int, int>* scanRanges, std::vector<long long>* samples, int& height,
+                 LatencyHistogram* insertLatencies = nullptr, LatencyHistogram* searchLatencies = nullptr,
+                 CounterTotals* counterTotals = nullptr, TreeOpCounters* accessCounts = nullptr);
+
+public:
+    explicit BenchmarkHarness(const HarnessConfig& harnessConfig = HarnessConfig());
+
+    void registerEngine(const std::string& name, const EngineFactory& factory);
+    void registerWorkload(const std::string& name, const WorkloadGenerator& generator);
+    void registerScenarioWorkloads();   // The five TestScenario data sets
+
+    const HarnessConfig& getConfig() const { return config; }
+    bool hasPerfCounters() const { return perf != nullptr; }
+    std::vector<std::string> getEngineNames() const;
+
+    // Runs one engine on a given data set; workload only labels the result
+    CaseResult runCase(const std::string& engine, const std::string& workload, const std::vector<int>& data);
+
+    // Every size x workload x engine; progress(done, total) after each case
+    std::vector<CaseResult> runAll(const std::vector<int>& sizes,
+                                   const std::function<void(size_t, size_t)>& progress = nullptr);
+
+    static LatencySummary summarizeLatency(const LatencyHistogram& histogram);
+
+    static void exportCSV(const std::vector<CaseResult>& results, const std::string& filename);
+    static void exportLatencyCSV(const std::vector<CaseResult>& results, const std::string& filename);
+    static void exportJSON(const std::vector<CaseResult>& results, const HarnessConfig& config,
+                           const std::string& filename);
+};
+
+// The in-memory trees both executables compare: BTree and BPlusTree at
+// btreeDegree, FixedBTree at BENCH_BTREE_DEGREE (its degree is a template
+// argument), BST, AVL and RedBlack
+void registerDefaultEngines(BenchmarkHarness& harness, int btreeDegree = BENCH_BTREE_DEGREE);
+
 // Disk I/O simulator
 class DiskSimulator {
 private:
@@ -2,6 +2,9 @@
 #define BST_H
 
 #include <iostream>
+#include <vector>
+#include <memory>
+#include "node_allocator.h"
 
 // Binary Search Tree Node
 template <typename T>
@@ -14,12 +17,53 @@ public:
     BSTNode(T k) : key(k), left(nullptr), right(nullptr) {}
 };
 
+// In-order forward iterator. The stack holds the ancestors whose key has
+// not been yielded yet, so each step is amortized O(1).
+template <typename T>
+class BSTIterator {
+private:
+    std::vector<BSTNode<T>*> stack;
+
+    void pushLeftSpine(BSTNode<T>* node) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+    }
+
+    template <typename> friend class BST;
+
+public:
+    BSTIterator() {}
+
+    const T& operator*() const { return stack.back()->key; }
+
+    BSTIterator& operator++() {
+        BSTNode<T>* node = stack.back();
+        stack.pop_back();
+        pushLeftSpine(node->right);
+        return *this;
+    }
+
+    bool operator==(const BSTIterator& other) const {
+        if (stack.empty() || other.stack.empty()) {
+            return stack.empty() && other.stack.empty();
+        }
+        return stack.back() == other.stack.back();
+    }
+    bool operator!=(const BSTIterator& other) const { return !(*this == other); }
+};
+
 // Binary Search Tree
 template <typename T>
 class BST {
 private:
     BSTNode<T>* root;
+    std::unique_ptr<NodeAllocator> allocator;
     
+    BSTNode<T>* createNode(T key);
+    void destroyNode(BSTNode<T>* node);
+
     // Helper functions (recursive)
     BSTNode<T>* insertHelper(BSTNode<T>* node, T key);
     BSTNode<T>* searchHelper(BSTNode<T>* node, T key);
@@ -28,13 +72,28 @@ private:
     void deleteTree(BSTNode<T>* node);
     
 public:
-    BST() : root(nullptr) {}
+    explicit BST(NodeAllocatorKind allocatorKind = NodeAllocatorKind::HEAP);
     ~BST();
+
+    BST(const BST&) = delete;
+    BST& operator=(const BST&) = delete;
+
 	BSTNode<T>* getRoot() { return root; }
     void insert(T key);
+    bool remove(T key);   // False if key is absent
     bool search(T key);
     void traverse();
     void printTree();
+
+    typedef BSTIterator<T> iterator;
+
+    // Ordered access
+    iterator begin();
+    iterator end() { return iterator(); }
+    iterator lowerBound(T key);              // First key >= key
+    std::vector<T> rangeScan(T lo, T hi);    // All keys in [lo, hi], in order
+
+    const NodeAllocator& getAllocator() const { return *allocator; }
 };
 
 
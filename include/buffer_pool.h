@@ -0,0 +1,110 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <functional>
+#include "page_file.h"
+
+// Page replacement policies the pool can be configured with
+enum class EvictionPolicy {
+    LRU,    // Least recently used
+    CLOCK,  // Second-chance approximation of LRU
+    TWO_Q   // FIFO probation queue + LRU main queue (Johnson & Shasha)
+};
+
+std::string evictionPolicyName(EvictionPolicy policy);
+
+// One slot of the pool holding a cached page
+struct BufferFrame {
+    PageId page_id;
+    int pin_count;
+    bool dirty;
+    bool valid;
+};
+
+// Decides which unpinned frame to give up when the pool is full
+class ReplacementPolicy {
+public:
+    virtual ~ReplacementPolicy() {}
+
+    // Called on every fetch; loaded is true when the page was just read in
+    virtual void recordAccess(size_t frame, PageId page, bool loaded) = 0;
+
+    // Picks an unpinned frame to evict and forgets it; with cleanOnly,
+    // dirty frames are skipped too. Returns false when nothing qualifies.
+    virtual bool evict(const std::vector<BufferFrame>& frames, size_t& victim, bool cleanOnly) = 0;
+
+protected:
+    static bool evictable(const BufferFrame& frame, bool cleanOnly) {
+        return frame.pin_count == 0 && !(cleanOnly && frame.dirty);
+    }
+};
+
+// Bounded cache of file pages. Callers pin a page with fetchPage/newPage,
+// use the returned buffer, and release it with unpinPage. Dirty pages are
+// written back when evicted or on flushAll().
+//
+// In no-steal mode dirty pages are never evicted, so nothing reaches the
+// file until flushAll(). A write-ahead log relies on this to keep the file
+// at its last checkpoint between checkpoints.
+class BufferPool {
+private:
+    PageFile& file;
+    size_t capacity;
+    EvictionPolicy policy;
+
+    std::vector<char> memory;
+    char* frame_base;   // First IO_ALIGNMENT boundary in memory, so direct I/O needs no copy
+    std::vector<BufferFrame> frames;
+    std::vector<size_t> free_frames;
+    std::unordered_map<PageId, size_t> page_table;
+    std::unique_ptr<ReplacementPolicy> replacer;
+    bool no_steal;
+    size_t dirty_pages;
+
+    long long hits;
+    long long misses;
+    long long evictions;
+    long long write_backs;
+
+    char* frameData(size_t frame) { return frame_base + frame * file.getPageSize(); }
+    size_t acquireFrame();
+    void writeBack(size_t frame);
+
+public:
+    BufferPool(PageFile& pageFile, size_t capacityPages, EvictionPolicy evictionPolicy);
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    char* fetchPage(PageId id);       // Pins the page, reading it on a miss
+    char* newPage(PageId& id);        // Allocates a zeroed, pinned, dirty page
+    void unpinPage(PageId id, bool dirty);
+    void flushAll();                  // Writes back every dirty page
+
+    // Calls visit for every dirty cached page
+    void forEachDirtyPage(const std::function<void(PageId, const char*)>& visit);
+
+    size_t getCapacity() const { return capacity; }
+    EvictionPolicy getPolicy() const { return policy; }
+    void setNoSteal(bool enabled) { no_steal = enabled; }
+    bool getNoSteal() const { return no_steal; }
+    size_t getDirtyPages() const { return dirty_pages; }
+
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    long long getEvictions() const { return evictions; }
+    long long getWriteBacks() const { return write_backs; }
+    double getHitRate() const {
+        long long total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+    void resetStats() { hits = 0; misses = 0; evictions = 0; write_backs = 0; }
+};
+
+#endif
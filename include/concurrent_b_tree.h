@@ -0,0 +1,89 @@
+#ifndef CONCURRENT_BTREE_H
+#define CONCURRENT_BTREE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "fixed_b_tree.h"
+
+// Version latch for optimistic lock coupling (Leis et al., "The ART of
+// practical synchronization"). Bit 1 is the write lock; unlocking adds 2
+// again, which carries into the counter, so every write critical section
+// leaves a new version behind. Readers take no lock: they remember the
+// version, read, and re-check it; a change means they raced a writer.
+class OptimisticLatch {
+private:
+    std::atomic<uint64_t> version;
+
+    static const uint64_t LOCKED = 2;
+
+public:
+    OptimisticLatch() : version(0) {}
+
+    // Version to validate against later. restart is set if a writer holds the latch.
+    uint64_t readLock(bool& restart) const;
+
+    // True if nothing was written since readLock returned v
+    bool validate(uint64_t v) const;
+
+    // Turn a validated read into the write lock, atomically with the check
+    bool upgrade(uint64_t v);
+
+    void writeUnlock();
+};
+
+// FixedBtreeNode plus a latch. Children point at ConcurrentNode, stored in
+// the base class array and cast back on the way down.
+template <typename T, int Degree>
+struct ConcurrentNode : FixedBtreeNode<T, Degree> {
+    OptimisticLatch latch;
+
+    explicit ConcurrentNode(bool leaf) : FixedBtreeNode<T, Degree>(leaf) {}
+
+    ConcurrentNode* child(int i) const { return static_cast<ConcurrentNode*>(this->children[i]); }
+};
+
+// Thread-safe B-tree using optimistic lock coupling over the FixedBTree
+// node layout. Lookups never write shared memory. Inserts descend
+// optimistically too and take exclusive latches only where they modify:
+// the leaf they insert into, or a parent/child pair on a proactive split
+// (the same top-down split rule as BTree::insert, which is what lets a
+// writer hold at most two latches at a time).
+//
+// There is no remove, so nodes are never freed while the tree is shared
+// and readers need no epoch-based reclamation.
+template <typename T, int Degree>
+class ConcurrentBTree {
+public:
+    typedef ConcurrentNode<T, Degree> Node;
+
+private:
+    std::atomic<Node*> root;
+    mutable std::atomic<long long> restarts;  // Optimistic attempts that had to start over
+
+    Node* allocateNode(bool leaf);
+    void destroy(Node* node);
+    void splitChild(Node* parent, int index, Node* child);
+    bool tryInsert(T key, bool& restart);
+    bool trySearch(T key, bool& restart) const;
+
+public:
+    ConcurrentBTree();
+    ~ConcurrentBTree();
+
+    ConcurrentBTree(const ConcurrentBTree&) = delete;
+    ConcurrentBTree& operator=(const ConcurrentBTree&) = delete;
+
+    // Safe to call from any number of threads concurrently
+    void insert(T key);
+    bool search(T key) const;
+
+    // Not thread-safe: call when no writer is running
+    std::vector<T> rangeScan(T lo, T hi) const;
+    int getHeight() const;
+
+    long long getRestarts() const { return restarts.load(std::memory_order_relaxed); }
+    void resetStats() { restarts.store(0, std::memory_order_relaxed); }
+};
+
+#endif
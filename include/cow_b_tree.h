@@ -0,0 +1,103 @@
+#ifndef COW_BTREE_H
+#define COW_BTREE_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+// Node of a copy-on-write B-tree. Never modified once published; children
+// are shared_ptrs, so a node lives exactly as long as some version can
+// still reach it.
+template <typename T>
+struct CowNode {
+    std::vector<T> keys;
+    std::vector<std::shared_ptr<const CowNode>> children;
+    bool is_leaf;
+
+    explicit CowNode(bool leaf) : is_leaf(leaf) {}
+};
+
+// One published state of the tree
+template <typename T>
+struct CowVersion {
+    std::shared_ptr<const CowNode<T>> root;
+    size_t num_keys;
+    uint64_t version;
+};
+
+// Read-only view of one version. It holds the version's root, so nothing
+// reachable from it is changed or freed while the snapshot exists, and
+// lookups through it take no latches at all.
+template <typename T>
+class CowSnapshot {
+private:
+    std::shared_ptr<const CowVersion<T>> state;
+
+public:
+    explicit CowSnapshot(std::shared_ptr<const CowVersion<T>> version) : state(std::move(version)) {}
+
+    bool search(T key) const;
+    std::vector<T> rangeScan(T lo, T hi) const;    // All keys in [lo, hi], in order
+    int getHeight() const;
+    size_t size() const { return state->num_keys; }
+    uint64_t getVersion() const { return state->version; }
+};
+
+// Btrfs-style copy-on-write B-tree. An insert copies the root-to-leaf path
+// (splitting full nodes on the way down, as BTree::insert does), then
+// publishes the new root in one atomic pointer swap. Readers take a
+// snapshot of the current version and search it without synchronisation;
+// versions nobody references any more are freed by the last shared_ptr to
+// let go, so no epoch scheme is needed.
+//
+// Writers are serialised by a mutex. The version pointer is swapped with
+// std::atomic_load/atomic_store on shared_ptr; libstdc++ implements those
+// with a short hashed spinlock, so taking a snapshot is a tiny critical
+// section, but nothing after that is.
+template <typename T>
+class CowBTree {
+public:
+    typedef CowNode<T> Node;
+    typedef std::shared_ptr<Node> NodePtr;
+    typedef std::shared_ptr<const Node> ConstNodePtr;
+
+private:
+    int min_degree;
+    std::shared_ptr<const CowVersion<T>> current;  // Only through std::atomic_load/atomic_store
+    std::mutex writer;
+
+    // Write amplification, updated under the writer mutex
+    long long inserts;
+    long long nodes_copied;      // Nodes allocated: path copies plus split halves
+    long long bytes_copied;
+    long long nodes_modified;    // Nodes an in-place tree would have written
+
+    size_t maxKeys() const { return static_cast<size_t>(2 * min_degree - 1); }
+    NodePtr copyNode(const ConstNodePtr& node);
+    void splitChild(Node& parent, int index, NodePtr& left, NodePtr& right);
+
+public:
+    explicit CowBTree(int degree);
+
+    CowBTree(const CowBTree&) = delete;
+    CowBTree& operator=(const CowBTree&) = delete;
+
+    // Safe to call from any number of threads concurrently
+    void insert(T key);
+    CowSnapshot<T> snapshot() const;
+    bool search(T key) const { return snapshot().search(key); }
+
+    std::vector<T> rangeScan(T lo, T hi) const { return snapshot().rangeScan(lo, hi); }
+    int getHeight() const { return snapshot().getHeight(); }
+    size_t size() const { return snapshot().size(); }
+    int getMinDegree() const { return min_degree; }
+
+    long long getInserts() const { return inserts; }
+    long long getNodesCopied() const { return nodes_copied; }
+    long long getBytesCopied() const { return bytes_copied; }
+    long long getNodesModified() const { return nodes_modified; }
+    void resetStats();
+};
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef DISK_BTREE_H
+#define DISK_BTREE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include "page_file.h"
+#include "buffer_pool.h"
+#include "wal.h"
+#include "async_page_reader.h"
+
+// On-disk node layout (one node per page):
+//
+//   +-----------------+----------------------+---------------------------+
+//   | header (8 bytes)| keys[2t-1] (T each)  | children[2t] (PageId each)|
+//   +-----------------+----------------------+---------------------------+
+//
+// Children are page IDs rather than pointers, so the whole tree lives in
+// a single file and every node visit is one page fetch.
+struct DiskNodeHeader {
+    uint32_t num_keys;
+    uint32_t is_leaf;
+};
+
+// Page 0 of the file describes the tree
+struct DiskTreeMeta {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t page_size;
+    uint32_t key_size;
+    uint32_t min_degree;
+    PageId root;
+    uint64_t num_keys;
+};
+
+static const uint32_t DISK_BTREE_MAGIC = 0x42545245;  // "BTRE"
+static const uint32_t DISK_BTREE_VERSION = 1;
+
+// Interprets a raw page buffer as a B-tree node. Keys and children are
+// accessed with memcpy so the page needs no particular alignment.
+template <typename T>
+class DiskNodeView {
+private:
+    char* data;
+    int max_keys;
+
+    char* keyPtr(int i) const { return data + sizeof(DiskNodeHeader) + i * sizeof(T); }
+    char* childPtr(int i) const {
+        return data + sizeof(DiskNodeHeader) + max_keys * sizeof(T) + i * sizeof(PageId);
+    }
+    DiskNodeHeader* header() const { return reinterpret_cast<DiskNodeHeader*>(data); }
+
+public:
+    DiskNodeView(char* page, int maxKeys) : data(page), max_keys(maxKeys) {}
+
+    void init(bool leaf) {
+        header()->num_keys = 0;
+        header()->is_leaf = leaf ? 1 : 0;
+    }
+
+    bool isLeaf() const { return header()->is_leaf != 0; }
+    int numKeys() const { return static_cast<int>(header()->num_keys); }
+    void setNumKeys(int n) { header()->num_keys = static_cast<uint32_t>(n); }
+    bool isFull() const { return numKeys() == max_keys; }
+
+    T key(int i) const {
+        T k;
+        std::memcpy(&k, keyPtr(i), sizeof(T));
+        return k;
+    }
+    void setKey(int i, T k) { std::memcpy(keyPtr(i), &k, sizeof(T)); }
+
+    PageId child(int i) const {
+        PageId id;
+        std::memcpy(&id, childPtr(i), sizeof(PageId));
+        return id;
+    }
+    void setChild(int i, PageId id) { std::memcpy(childPtr(i), &id, sizeof(PageId)); }
+
+    // Moves keys[from..numKeys) and children[from..numKeys] one slot right
+    void shiftKeysRight(int from) {
+        std::memmove(keyPtr(from + 1), keyPtr(from), (numKeys() - from) * sizeof(T));
+    }
+    void shiftChildrenRight(int from) {
+        std::memmove(childPtr(from + 1), childPtr(from), (numKeys() + 1 - from) * sizeof(PageId));
+    }
+};
+
+// Tuning knobs for DiskBTree
+struct DiskBTreeConfig {
+    static const size_t MIN_POOL_PAGES = 4;       // Pages pinned at once during a split
+    static const size_t DEFAULT_POOL_PAGES = 256;
+    static const size_t DEFAULT_GROUP_COMMIT = 1;
+
+    size_t page_size;
+    int min_degree;          // 0 = largest degree whose node fits in one page
+    size_t pool_pages;       // Buffer pool capacity in pages
+    EvictionPolicy policy;
+    bool direct_io;          // Open the file O_DIRECT (buffered if the file system refuses)
+
+    std::string wal_path;        // Write-ahead log file; empty = no log, not crash-safe
+    size_t group_commit;         // Logged inserts per fdatasync
+    size_t checkpoint_records;   // Log records between checkpoints; 0 = only when dirty pages fill the pool
+
+    DiskBTreeConfig()
+        : page_size(PAGE_SIZE_4K), min_degree(0),
+          pool_pages(DEFAULT_POOL_PAGES), policy(EvictionPolicy::LRU), direct_io(false),
+          group_commit(DEFAULT_GROUP_COMMIT), checkpoint_records(0) {}
+};
+
+// B-tree whose nodes are fixed-size pages in a single file. Nodes are
+// addressed by page ID and accessed through a bounded BufferPool, so the
+// pool counters give the real number of page I/Os per operation instead
+// of a height-based estimate.
+//
+// Durable mode (config.wal_path set): each insert is logged before it is
+// applied, and the pool runs no-steal, so between checkpoints the file
+// stays exactly as the last checkpoint left it. A checkpoint logs images
+// of all dirty pages and commits them before writing the pages in place
+// (a double-write: a crash half-way through the write-back is repaired
+// from the images), then empties the log. Reopening the tree replays
+// whatever the log holds. An insert is durable once its group commits.
+template <typename T>
+class DiskBTree {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "DiskBTree keys are stored as raw bytes and must be trivially copyable");
+
+private:
+    PageFile file;
+    BufferPool pool;
+    PageId root;
+    int min_degree;
+    int max_keys;
+    uint64_t num_keys;
+    int height;
+
+    std::unique_ptr<WriteAheadLog> wal;   // Null unless durable
+    size_t checkpoint_records;
+    long long checkpoints;
+
+    void writeMeta();
+    void readMeta();
+    void recover();
+    bool checkpointDue() const;
+    void insertKey(T key);
+    char* splitChild(char* parentPage, int index, char* childPage, PageId& siblingId);
+    void insertNonFull(PageId id, char* page, bool dirty, T key);
+    DiskNodeView<T> view(char* page) { return DiskNodeView<T>(page, max_keys); }
+
+public:
+    // Creates a new tree file (truncating any existing one), or reopens an
+    // existing one when create is false.
+    DiskBTree(const std::string& path, const DiskBTreeConfig& config = DiskBTreeConfig(),
+              bool create = true);
+    ~DiskBTree();
+
+    void insert(T key);
+    bool search(T key);
+
+    // Read paths that go through an AsyncPageReader on getPageFile()
+    // instead of the buffer pool, so flush() before using them. Every
+    // probe descends independently and the reader's queue is kept full,
+    // so up to its queue depth of node reads are in flight at once.
+    // found[i] is set for probes[i]; returns the pages read.
+    size_t searchBatch(const T* probes, size_t count, std::vector<bool>& found, AsyncPageReader& reader);
+    // All keys in [lo, hi], in order. Every subtree overlapping the range
+    // is read as soon as its parent arrives, which prefetches the leaves
+    // ahead of the scan.
+    std::vector<T> rangeScan(T lo, T hi, AsyncPageReader& reader);
+
+    void flush();   // Write back dirty pages and fdatasync the file (a checkpoint when durable)
+
+    // Durable mode only
+    void commit();       // Force the current commit group to disk
+    void checkpoint();   // Write back dirty pages via the log and empty it
+    bool isDurable() const { return wal != nullptr; }
+    WriteAheadLog* getLog() { return wal.get(); }
+    long long getCheckpoints() const { return checkpoints; }
+
+    int getHeight();
+    uint64_t size() const { return num_keys; }
+    int getMinDegree() const { return min_degree; }
+    size_t getPageSize() const { return file.getPageSize(); }
+    PageId getNumPages() const { return file.getNumPages(); }
+
+    BufferPool& getBufferPool() { return pool; }
+    PageFile& getPageFile() { return file; }
+    long long getPageReads() const { return file.getPageReads(); }
+    long long getPageWrites() const { return file.getPageWrites(); }
+    void resetIOStats() { file.resetStats(); pool.resetStats(); }
+
+    // Largest minimum degree t such that a node with 2t-1 keys and 2t
+    // children fits in a page of the given size
+    static int maxDegreeForPage(size_t pageSize) {
+        return static_cast<int>((pageSize - sizeof(DiskNodeHeader) + sizeof(T)) /
+                                (2 * (sizeof(T) + sizeof(PageId))));
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef FIXED_BTREE_H
+#define FIXED_BTREE_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "node_search.h"
+#include "node_allocator.h"
+
+static const size_t CACHE_LINE_SIZE = 64;
+
+// B-tree node with capacity fixed at compile time. Keys and child pointers
+// are inline arrays, so a node is one contiguous, cache-line aligned block
+// instead of a header plus two separately allocated vectors. Unused key
+// slots (padded up to a multiple of 8) hold numeric_limits<T>::max(), so
+// the in-node search always runs over KEY_SLOTS keys: a constant trip
+// count the compiler can fully unroll and vectorize.
+template <typename T, int Degree>
+struct alignas(CACHE_LINE_SIZE) FixedBtreeNode {
+    static const int MAX_KEYS = 2 * Degree - 1;
+    static const int MAX_CHILDREN = 2 * Degree;
+    static const int KEY_SLOTS = (MAX_KEYS + 7) / 8 * 8;
+
+    // Up to this many slots a full compare-and-count beats halving
+    static const int LINEAR_SEARCH_SLOTS = 32;
+
+    int32_t num_keys;
+    bool is_leaf;
+    T keys[KEY_SLOTS];
+    FixedBtreeNode* children[MAX_CHILDREN];
+
+    explicit FixedBtreeNode(bool leaf) : num_keys(0), is_leaf(leaf) {
+        for (int i = 0; i < KEY_SLOTS; i++) {
+            keys[i] = std::numeric_limits<T>::max();
+        }
+    }
+
+    bool isFull() const { return num_keys == MAX_KEYS; }
+
+    // Index of the first key >= key. Sentinels are never < key.
+    int lowerBound(T key) const {
+        if (KEY_SLOTS <= LINEAR_SEARCH_SLOTS) {
+            int count = 0;
+            for (int i = 0; i < KEY_SLOTS; i++) {
+                count += keys[i] < key;
+            }
+            return count;
+        }
+        return static_cast<int>(lowerBoundBranchless(keys, KEY_SLOTS, key));
+    }
+
+    // Index of the first key > key. Sentinels compare <= max(), so clamp.
+    int upperBound(T key) const {
+        int count;
+        if (KEY_SLOTS <= LINEAR_SEARCH_SLOTS) {
+            count = 0;
+            for (int i = 0; i < KEY_SLOTS; i++) {
+                count += keys[i] <= key;
+            }
+        } else {
+            count = static_cast<int>(upperBoundBranchless(keys, KEY_SLOTS, key));
+        }
+        return count < num_keys ? count : num_keys;
+    }
+};
+
+
+// B-tree with compile-time degree and FixedBtreeNode nodes. Same proactive
+// split algorithm as BTree; only the node layout differs.
+template <typename T, int Degree>
+class FixedBTree {
+public:
+    typedef FixedBtreeNode<T, Degree> Node;
+
+private:
+    Node* root;
+    std::unique_ptr<NodeAllocator> allocator;
+
+    Node* allocateNode(bool leaf);
+    void freeNode(Node* node);
+    void destroy(Node* node);
+    void splitChild(Node* parent, int index, Node* child);
+    bool scan(Node* node, T lo, T hi, std::vector<T>& out);
+
+public:
+    explicit FixedBTree(NodeAllocatorKind allocatorKind = NodeAllocatorKind::HEAP)
+        : root(nullptr), allocator(makeNodeAllocator(allocatorKind, sizeof(Node), alignof(Node))) {}
+    ~FixedBTree();
+
+    FixedBTree(const FixedBTree&) = delete;
+    FixedBTree& operator=(const FixedBTree&) = delete;
+
+    void insert(T key);
+    bool search(T key) const;
+    std::vector<T> rangeScan(T lo, T hi);    // All keys in [lo, hi], in order
+
+    // Looks up probes[0..count) with up to group lookups in flight. Each
+    // lookup is a small state machine: after picking a child it prefetches
+    // that node and yields to the next lookup instead of stalling on the
+    // miss. found[i] is set for probes[i]; returns the number found.
+    size_t searchInterleaved(const T* probes, size_t count, std::vector<bool>& found,
+                             int group = DEFAULT_INTERLEAVE_GROUP) const;
+
+    static const int DEFAULT_INTERLEAVE_GROUP = 16;
+
+    int getHeight() const;
+    Node* getRoot() { return root; }
+
+    const NodeAllocator& getAllocator() const { return *allocator; }
+
+    static int degree() { return Degree; }
+    static size_t nodeBytes() { return sizeof(Node); }
+};
+
+
+// Largest degree whose node fits in NodeBytes, for sizing a FixedBTree
+// from a target node size (cache line multiple or page) instead of a
+// hand-picked degree. Header is num_keys + is_leaf padded to sizeof(void*).
+template <typename T, size_t NodeBytes>
+struct FixedDegreeForBytes {
+    static const int value =
+        static_cast<int>((NodeBytes - sizeof(void*) + sizeof(T)) / (2 * (sizeof(T) + sizeof(void*))));
+};
+
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef FROZEN_BTREE_H
+#define FROZEN_BTREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// File layout of a FrozenBTree. Everything is addressed by byte offset
+// from the start of the file, so the file is used as-is wherever it is
+// mapped:
+//
+//   +--------------+------------------------+----------------------------+
+//   | header page  | leaves, in key order   | internal levels, root last |
+//   +--------------+------------------------+----------------------------+
+//
+// Every node is node_bytes long and starts with a FrozenNodeHeader.
+// Leaves hold keys only; an internal node with k keys holds k keys
+// followed by k + 1 child offsets (uint64), where key i is the first key
+// of child i + 1. Leaves are contiguous, so the leaf after the one at
+// offset x is at x + node_bytes.
+struct FrozenTreeHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t key_size;
+    uint32_t node_bytes;
+    uint64_t num_keys;
+    uint64_t num_leaves;
+    uint64_t root_offset;    // 0 for an empty tree
+    uint64_t file_bytes;
+    uint32_t height;
+    uint32_t body_crc;       // CRC-32 of everything after the header page
+    uint32_t header_crc;     // CRC-32 of this struct with header_crc = 0
+    uint32_t reserved;
+};
+
+struct FrozenNodeHeader {
+    uint32_t num_keys;
+    uint32_t level;          // 0 = leaf
+};
+
+static const uint32_t FROZEN_BTREE_MAGIC = 0x425A5246;  // "FRZB"
+static const uint32_t FROZEN_BTREE_VERSION = 1;
+
+// Read-only B+tree serialized once with write() and then opened with
+// mmap: the constructor checks the header and maps the file, nothing is
+// deserialized, and lookups walk the mapped nodes directly. Opening is
+// independent of the number of keys; pages are faulted in as lookups
+// touch them. Duplicate keys are kept, as in BTree.
+template <typename T>
+class FrozenBTree {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "FrozenBTree keys are stored as raw bytes and must be trivially copyable");
+
+private:
+    std::string path;
+    int fd;
+    const char* base;
+    size_t mapped_bytes;
+    FrozenTreeHeader header;
+
+    const FrozenNodeHeader* node(uint64_t offset) const {
+        return reinterpret_cast<const FrozenNodeHeader*>(base + offset);
+    }
+    const T* keys(const FrozenNodeHeader* n) const { return reinterpret_cast<const T*>(n + 1); }
+    uint64_t child(const FrozenNodeHeader* n, size_t i) const;
+    uint64_t lowerBoundLeaf(T key, size_t& pos) const;
+
+public:
+    static const size_t DEFAULT_NODE_BYTES = 4096;
+
+    // Keys per node for a node size (leaves, and internal nodes which also
+    // carry child offsets)
+    static size_t leafCapacity(size_t nodeBytes) { return (nodeBytes - sizeof(FrozenNodeHeader)) / sizeof(T); }
+    static size_t internalCapacity(size_t nodeBytes) {
+        return (nodeBytes - sizeof(FrozenNodeHeader) - sizeof(uint64_t)) / (sizeof(T) + sizeof(uint64_t));
+    }
+
+    // Serializes sorted keys bottom-up into a new file at path. The file
+    // is written under a temporary name, synced and renamed into place,
+    // so readers never see a partial tree.
+    static void write(const std::string& path, const std::vector<T>& sortedKeys,
+                      size_t nodeBytes = DEFAULT_NODE_BYTES);
+
+    // Maps the file and validates its header (not the body, see verify)
+    explicit FrozenBTree(const std::string& filename);
+    ~FrozenBTree();
+
+    FrozenBTree(const FrozenBTree&) = delete;
+    FrozenBTree& operator=(const FrozenBTree&) = delete;
+
+    bool search(T key) const;
+    std::vector<T> rangeScan(T lo, T hi) const;    // All keys in [lo, hi], in order
+
+    // Checks the body checksum, which reads the whole file
+    bool verify() const;
+
+    int getHeight() const { return static_cast<int>(header.height); }
+    uint64_t size() const { return header.num_keys; }
+    uint64_t getFileBytes() const { return header.file_bytes; }
+    size_t getNodeBytes() const { return header.node_bytes; }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+// Exact access counting inside the tree code, for modelling what an
+// operation would cost on storage: nodes visited on the way down (one
+// page read each when nothing is cached), key comparisons, node splits
+// (each one writes the split node, its new sibling and the parent) and
+// bytes shifted or copied inside nodes.
+//
+// Compiled in only with -DTREE_INSTRUMENTATION (make INSTRUMENT=1).
+// Otherwise every TREE_COUNT_* macro expands to nothing, so the trees
+// are the same code as before. Counters are per thread.
+
+struct TreeOpCounters {
+    unsigned long long nodes_visited;
+    unsigned long long key_comparisons;
+    unsigned long long node_splits;
+    unsigned long long bytes_moved;
+};
+
+#ifdef TREE_INSTRUMENTATION
+
+static const bool TREE_INSTRUMENTED = true;
+extern thread_local TreeOpCounters tree_op_counters;
+
+#define TREE_COUNT_NODE_VISIT()     (tree_op_counters.nodes_visited++)
+#define TREE_COUNT_COMPARISONS(n)   (tree_op_counters.key_comparisons += (n))
+#define TREE_COUNT_SPLIT()          (tree_op_counters.node_splits++)
+#define TREE_COUNT_BYTES_MOVED(n)   (tree_op_counters.bytes_moved += (n))
+
+#else
+
+static const bool TREE_INSTRUMENTED = false;
+
+#define TREE_COUNT_NODE_VISIT()     ((void)0)
+#define TREE_COUNT_COMPARISONS(n)   ((void)0)
+#define TREE_COUNT_SPLIT()          ((void)0)
+#define TREE_COUNT_BYTES_MOVED(n)   ((void)0)
+
+#endif
+
+// This thread's counters; all zero when instrumentation is compiled out
+void resetTreeOpCounters();
+TreeOpCounters readTreeOpCounters();
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Log-linear (HdrHistogram-style) histogram of per-operation latencies in
+// nanoseconds. Values below 2 * SUB_BUCKETS are counted exactly; above
+// that every power-of-two range is split into SUB_BUCKETS equal buckets,
+// so a reported value is within 1 / SUB_BUCKETS (under 1%) of the real
+// one at any magnitude. The bucket array is fixed (58 ranges x 128), and
+// record() is a shift and an increment, cheap enough to call once per
+// insert or lookup in a benchmark loop.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 7;
+    static const uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t min_value;
+    uint64_t max_value;
+    double sum;
+
+    static size_t bucketIndex(uint64_t value) {
+        if (value < 2 * SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+        return static_cast<size_t>(shift) * SUB_BUCKETS + static_cast<size_t>(value >> shift);
+    }
+    static uint64_t bucketHighest(size_t index);   // Largest value counted in a bucket
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t valueNs) {
+        counts[bucketIndex(valueNs)]++;
+        total++;
+        sum += static_cast<double>(valueNs);
+        if (valueNs < min_value) min_value = valueNs;
+        if (valueNs > max_value) max_value = valueNs;
+    }
+
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    // Nearest-rank percentile, fraction in [0, 1]. Reports the top of the
+    // bucket the rank falls in (never above the recorded maximum), so a
+    // percentile is never understated.
+    uint64_t percentile(double fraction) const;
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total == 0 ? 0 : min_value; }
+    uint64_t max() const { return max_value; }
+    double mean() const { return total == 0 ? 0.0 : sum / total; }
+};
+
+#endif
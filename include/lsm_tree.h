@@ -0,0 +1,120 @@
+#ifndef LSM_TREE_H
+#define LSM_TREE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include "page_file.h"
+#include "rb_tree.h"
+
+// How sorted runs are merged as they pile up
+enum class CompactionPolicy {
+    LEVELED,  // One run per level; a level that outgrows its budget is merged into the next
+    TIERED    // Up to size_ratio runs per level; a full level is merged into one run of the next
+};
+
+std::string compactionPolicyName(CompactionPolicy policy);
+
+// Tuning knobs for LSMTree
+struct LSMConfig {
+    static const size_t DEFAULT_MEMTABLE_KEYS = 65536;
+    static const size_t DEFAULT_SIZE_RATIO = 10;
+    static const size_t DEFAULT_L0_RUNS = 4;
+
+    std::string directory;   // Where run files are created
+    size_t memtable_keys;    // The memtable is flushed as a run at this many keys
+    size_t page_size;        // Block size of the run files
+    size_t size_ratio;       // Capacity growth from one level to the next
+    size_t l0_runs;          // LEVELED: flushed runs that trigger a level-0 compaction
+    CompactionPolicy policy;
+
+    LSMConfig()
+        : directory("results"), memtable_keys(DEFAULT_MEMTABLE_KEYS), page_size(PAGE_SIZE_4K),
+          size_ratio(DEFAULT_SIZE_RATIO), l0_runs(DEFAULT_L0_RUNS), policy(CompactionPolicy::LEVELED) {}
+};
+
+// Immutable sorted run in its own file. Keys are packed into blocks of
+// one page each (a key count, then the keys); the first key of every
+// block stays in memory as a fence pointer, so a point lookup reads at
+// most one block of the run.
+template <typename T>
+struct LSMRun {
+    std::unique_ptr<PageFile> file;
+    std::vector<T> fences;
+    T min_key;
+    T max_key;
+    size_t num_keys;
+};
+
+// Log-structured merge tree: inserts go to an in-memory memtable (a
+// red-black tree), which is written out as a sorted run when full. Runs
+// are never modified, only merged by compaction, so every write to disk
+// is sequential and the cost shows up as write amplification instead of
+// random page writes. Lookups check the memtable, then the runs from
+// newest to oldest, which is the read amplification. Same interface and
+// set semantics as the in-memory trees (duplicates are ignored).
+template <typename T>
+class LSMTree {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "LSMTree keys are stored as raw bytes and must be trivially copyable");
+
+private:
+    typedef std::unique_ptr<LSMRun<T>> RunPtr;
+
+    LSMConfig config;
+    std::string file_prefix;    // Run files are file_prefix + run id
+    size_t next_run_id;
+    std::unique_ptr<RBTree<T>> memtable;
+    std::vector<std::vector<RunPtr>> levels;   // Within a level, newest run last
+
+    long long inserts;
+    long long pages_written;
+    long long lookup_reads;       // Blocks read by search and rangeScan
+    long long compaction_reads;   // Blocks read while merging
+    long long compactions;
+
+    size_t keysPerBlock() const { return (config.page_size - sizeof(uint32_t)) / sizeof(T); }
+    size_t levelCapacity(size_t level) const;
+    bool levelFull(size_t level) const;
+
+    void readBlock(const LSMRun<T>& run, size_t block, std::vector<T>& keys, long long& counter);
+    RunPtr writeRun(const std::vector<const LSMRun<T>*>& inputs, const std::vector<T>* memtableKeys);
+    void removeRun(RunPtr& run);
+    void flushMemtable();
+    void compact(size_t level);
+    bool searchRun(const LSMRun<T>& run, T key);
+
+public:
+    explicit LSMTree(const LSMConfig& treeConfig = LSMConfig());
+    ~LSMTree();
+
+    LSMTree(const LSMTree&) = delete;
+    LSMTree& operator=(const LSMTree&) = delete;
+
+    void insert(T key);
+    bool search(T key);
+    std::vector<T> rangeScan(T lo, T hi);    // All keys in [lo, hi], in order
+    void flush();                            // Write the memtable out as a run now
+
+    size_t getLevels() const { return levels.size(); }
+    size_t getRuns() const;
+    size_t getMemtableKeys() const { return memtable->size(); }
+    size_t getDiskKeys() const;
+    CompactionPolicy getPolicy() const { return config.policy; }
+
+    long long getInserts() const { return inserts; }
+    long long getPagesWritten() const { return pages_written; }
+    long long getLookupReads() const { return lookup_reads; }
+    long long getCompactionReads() const { return compaction_reads; }
+    long long getCompactions() const { return compactions; }
+    void resetReadStats() { lookup_reads = 0; }
+
+    // Bytes written to run files per byte of keys inserted
+    double writeAmplification() const {
+        return inserts == 0 ? 0.0
+                            : static_cast<double>(pages_written) * config.page_size / (inserts * sizeof(T));
+    }
+};
+
+#endif
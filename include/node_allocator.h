@@ -0,0 +1,111 @@
+#ifndef NODE_ALLOCATOR_H
+#define NODE_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Where tree nodes come from
+enum class NodeAllocatorKind {
+    HEAP,   // Global operator new/delete per node (the original behaviour)
+    ARENA,  // Bump pointer into large blocks; frees are no-ops
+    SLAB    // Fixed-size slots carved from large blocks, recycled via a free list
+};
+
+std::string nodeAllocatorName(NodeAllocatorKind kind);
+
+// Source of node memory for a tree. A tree owns its allocator, so when
+// releasesInBulk() is true the tree can skip its per-node teardown walk
+// and let the allocator hand back whole blocks instead.
+class NodeAllocator {
+protected:
+    size_t bytes_reserved;  // Obtained from the system
+    size_t bytes_in_use;    // Handed out and not yet deallocated
+    long long allocations;
+
+public:
+    NodeAllocator() : bytes_reserved(0), bytes_in_use(0), allocations(0) {}
+    virtual ~NodeAllocator() {}
+
+    NodeAllocator(const NodeAllocator&) = delete;
+    NodeAllocator& operator=(const NodeAllocator&) = delete;
+
+    virtual void* allocate(size_t bytes, size_t alignment) = 0;
+    virtual void deallocate(void* ptr, size_t bytes) = 0;
+    virtual bool releasesInBulk() const = 0;
+    virtual NodeAllocatorKind kind() const = 0;
+
+    size_t bytesReserved() const { return bytes_reserved; }
+    size_t bytesInUse() const { return bytes_in_use; }
+    long long getAllocations() const { return allocations; }
+};
+
+// One aligned allocation per node. Reserved bytes only count the requested
+// sizes; malloc's own headers and rounding are not visible from here.
+class HeapNodeAllocator : public NodeAllocator {
+public:
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes) override;
+    bool releasesInBulk() const override { return false; }
+    NodeAllocatorKind kind() const override { return NodeAllocatorKind::HEAP; }
+};
+
+// Nodes are packed back to back into blocks of block_size bytes.
+// Individual frees only update the counters; the memory comes back when
+// the arena is destroyed, one free() per block.
+class ArenaNodeAllocator : public NodeAllocator {
+private:
+    size_t block_size;
+    std::vector<char*> blocks;
+    char* cursor;
+    char* limit;
+
+public:
+    explicit ArenaNodeAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~ArenaNodeAllocator();
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes) override;
+    bool releasesInBulk() const override { return true; }
+    NodeAllocatorKind kind() const override { return NodeAllocatorKind::ARENA; }
+
+    size_t getNumBlocks() const { return blocks.size(); }
+
+    static const size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+};
+
+// Every slot is slot_size bytes (the node size rounded up to its
+// alignment), so freed slots can be reused by later nodes. Suits trees
+// that delete as well as insert; the arena never reuses memory.
+class SlabNodeAllocator : public NodeAllocator {
+private:
+    size_t slot_size;
+    size_t slot_alignment;
+    size_t slots_per_block;
+    std::vector<char*> blocks;
+    char* cursor;
+    char* limit;
+
+    struct FreeSlot { FreeSlot* next; };
+    FreeSlot* free_list;
+
+public:
+    SlabNodeAllocator(size_t objectSize, size_t alignment,
+                      size_t blockSize = ArenaNodeAllocator::DEFAULT_BLOCK_SIZE);
+    ~SlabNodeAllocator();
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes) override;
+    bool releasesInBulk() const override { return true; }
+    NodeAllocatorKind kind() const override { return NodeAllocatorKind::SLAB; }
+
+    size_t getSlotSize() const { return slot_size; }
+    size_t getNumBlocks() const { return blocks.size(); }
+};
+
+// Builds an allocator for nodes of the given size and alignment
+std::unique_ptr<NodeAllocator> makeNodeAllocator(NodeAllocatorKind kind,
+                                                 size_t nodeSize, size_t nodeAlignment);
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef NODE_SEARCH_H
+#define NODE_SEARCH_H
+
+#include <cstddef>
+#include <string>
+
+// How a node locates a key among its sorted keys
+enum class NodeSearchMode {
+    LINEAR,  // Scalar scan from the left (the original loop)
+    BINARY,  // Branchless binary search (conditional moves, no mispredicts)
+    SIMD     // SSE2/AVX2 compare + movemask/popcount for int keys
+};
+
+std::string nodeSearchModeName(NodeSearchMode mode);
+
+// Instruction set the SIMD mode dispatched to on this CPU: "AVX2", "SSE2" or "scalar"
+const char* simdSearchIsa();
+
+
+// === Scalar building blocks ===
+// lowerBound*: number of keys strictly less than key (index of first key >= key)
+// upperBound*: number of keys less than or equal to key (index of first key > key)
+
+template <typename T>
+inline size_t lowerBoundLinear(const T* keys, size_t n, const T& key) {
+    size_t i = 0;
+    while (i < n && keys[i] < key) {
+        i++;
+    }
+    return i;
+}
+
+template <typename T>
+inline size_t upperBoundLinear(const T* keys, size_t n, const T& key) {
+    size_t i = 0;
+    while (i < n && !(key < keys[i])) {
+        i++;
+    }
+    return i;
+}
+
+// Halving without an early exit: the only data-dependent choice is which
+// base to keep, which compiles to a conditional move instead of a branch
+template <typename T>
+inline size_t lowerBoundBranchless(const T* keys, size_t n, const T& key) {
+    if (n == 0) return 0;
+    const T* base = keys;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (base[half] < key) ? base + half : base;
+        n -= half;
+    }
+    return (base - keys) + (*base < key ? 1 : 0);
+}
+
+template <typename T>
+inline size_t upperBoundBranchless(const T* keys, size_t n, const T& key) {
+    if (n == 0) return 0;
+    const T* base = keys;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (key < base[half]) ? base : base + half;
+        n -= half;
+    }
+    return (base - keys) + (key < *base ? 0 : 1);
+}
+
+
+// === SIMD (int keys only, runtime-dispatched in node_search.cpp) ===
+size_t lowerBoundSimd(const int* keys, size_t n, int key);
+size_t upperBoundSimd(const int* keys, size_t n, int key);
+
+
+// === Mode dispatch used by the tree nodes ===
+// Key types without a vector path fall back to the scalar scan for SIMD.
+
+template <typename T>
+inline size_t nodeLowerBound(const T* keys, size_t n, const T& key, NodeSearchMode mode) {
+    return mode == NodeSearchMode::BINARY ? lowerBoundBranchless(keys, n, key)
+                                          : lowerBoundLinear(keys, n, key);
+}
+
+template <typename T>
+inline size_t nodeUpperBound(const T* keys, size_t n, const T& key, NodeSearchMode mode) {
+    return mode == NodeSearchMode::BINARY ? upperBoundBranchless(keys, n, key)
+                                          : upperBoundLinear(keys, n, key);
+}
+
+inline size_t nodeLowerBound(const int* keys, size_t n, const int& key, NodeSearchMode mode) {
+    switch (mode) {
+        case NodeSearchMode::BINARY: return lowerBoundBranchless(keys, n, key);
+        case NodeSearchMode::SIMD:   return lowerBoundSimd(keys, n, key);
+        default:                     return lowerBoundLinear(keys, n, key);
+    }
+}
+
+inline size_t nodeUpperBound(const int* keys, size_t n, const int& key, NodeSearchMode mode) {
+    switch (mode) {
+        case NodeSearchMode::BINARY: return upperBoundBranchless(keys, n, key);
+        case NodeSearchMode::SIMD:   return upperBoundSimd(keys, n, key);
+        default:                     return upperBoundLinear(keys, n, key);
+    }
+}
+
+// === Comparison counts for the access counters (instrumentation.h) ===
+// Key comparisons a lower/upper bound search of n keys made to land at pos
+
+// The scan stops one past pos, or at the end
+inline size_t linearSearchComparisons(size_t n, size_t pos) {
+    return pos < n ? pos + 1 : n;
+}
+
+// ceil(log2 n) halvings and one final check, wherever the key lands
+inline size_t branchlessSearchComparisons(size_t n) {
+    if (n == 0) return 0;
+    size_t comparisons = 1;
+    while (n > 1) {
+        n -= n / 2;
+        comparisons++;
+    }
+    return comparisons;
+}
+
+// Keys per vector of the dispatched SIMD kernels: 8 (AVX2), 4 (SSE2), 1 (scalar)
+size_t simdSearchLanes();
+
+// The SIMD kernels compare a whole vector of lanes keys at a time and
+// return at the first vector that holds the answer; only when every full
+// vector is passed do they scan the remaining keys like LINEAR
+inline size_t simdSearchComparisons(size_t n, size_t pos, size_t lanes) {
+    size_t vector_end = lanes > 1 ? n / lanes * lanes : 0;
+    if (pos < vector_end) {
+        return (pos / lanes + 1) * lanes;
+    }
+    return vector_end + linearSearchComparisons(n - vector_end, pos - vector_end);
+}
+
+// Same dispatch as nodeLowerBound/nodeUpperBound: SIMD is the linear scan
+// for key types without a vector path
+template <typename T>
+inline size_t nodeSearchComparisons(const T*, size_t n, size_t pos, NodeSearchMode mode) {
+    return mode == NodeSearchMode::BINARY ? branchlessSearchComparisons(n)
+                                          : linearSearchComparisons(n, pos);
+}
+
+inline size_t nodeSearchComparisons(const int*, size_t n, size_t pos, NodeSearchMode mode) {
+    switch (mode) {
+        case NodeSearchMode::BINARY: return branchlessSearchComparisons(n);
+        case NodeSearchMode::SIMD:   return simdSearchComparisons(n, pos, simdSearchLanes());
+        default:                     return linearSearchComparisons(n, pos);
+    }
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef PAGE_FILE_H
+#define PAGE_FILE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Page identifiers are 32-bit offsets into the file (in units of pages).
+// Page 0 is always the metadata page, so 0 doubles as the "no page" value.
+typedef uint32_t PageId;
+static const PageId INVALID_PAGE_ID = 0;
+
+// Common page sizes for the on-disk tree
+static const size_t PAGE_SIZE_4K = 4096;
+static const size_t PAGE_SIZE_16K = 16384;
+
+// A single file split into fixed-size pages, accessed with pread/pwrite.
+// Every call goes straight to the kernel, so the read/write counters are
+// the real number of page I/Os issued.
+//
+// With direct I/O the file is opened O_DIRECT, so reads and writes bypass
+// the page cache and a read costs a real device access. O_DIRECT needs
+// buffers aligned to IO_ALIGNMENT; unaligned callers go through an
+// internal bounce buffer. File systems that refuse O_DIRECT (older tmpfs) fall
+// back to buffered I/O, which isDirect() reports.
+class PageFile {
+public:
+    static const size_t IO_ALIGNMENT = 4096;
+
+private:
+    int fd;
+    size_t page_size;
+    PageId num_pages;
+    std::string path;
+    bool direct;
+    char* bounce;   // Aligned page buffer, direct I/O only
+
+    long long page_reads;
+    long long page_writes;
+
+public:
+    // Opens (or creates) the file. If truncate is true, existing content is discarded.
+    PageFile(const std::string& filename, size_t pageSize, bool truncate, bool directIO = false);
+    ~PageFile();
+
+    PageFile(const PageFile&) = delete;
+    PageFile& operator=(const PageFile&) = delete;
+
+    void readPage(PageId id, void* buffer);
+    void writePage(PageId id, const void* buffer);
+    PageId allocatePage();   // Reserves the next page id at the end of the file
+    void sync();             // fdatasync()
+    void dropCache();        // Evicts the file from the page cache (buffered I/O only)
+
+    size_t getPageSize() const { return page_size; }
+    PageId getNumPages() const { return num_pages; }
+    const std::string& getPath() const { return path; }
+    bool isDirect() const { return direct; }
+    int getDescriptor() const { return fd; }   // For I/O issued outside this class
+
+    long long getPageReads() const { return page_reads; }
+    long long getPageWrites() const { return page_writes; }
+    void resetStats() { page_reads = 0; page_writes = 0; }
+};
+
+#endif
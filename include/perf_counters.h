@@ -0,0 +1,55 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <string>
+#include <cstdint>
+
+enum class PerfEvent {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,      // L1 data cache read misses
+    LLC_MISSES,      // Last-level cache misses
+    BRANCH_MISSES,
+    DTLB_MISSES      // Data TLB read misses
+};
+static const int PERF_EVENTS = 6;
+
+std::string perfEventName(PerfEvent event);
+
+// Counts of one measured region. A counter that could not be opened, or
+// never got scheduled on the PMU, is not valid.
+struct PerfReading {
+    double values[PERF_EVENTS];
+    bool valid[PERF_EVENTS];
+};
+
+// Hardware performance counters of the calling thread, opened with the
+// raw perf_event_open syscall and counted in user space only, which
+// kernel.perf_event_paranoid <= 2 allows. Every event is opened on its
+// own, so a CPU or VM without one of them (no LLC event, no PMU at all)
+// just loses that column. When the PMU has fewer counters than events,
+// the kernel multiplexes them and readings are scaled by the time each
+// was actually counting.
+class PerfCounters {
+private:
+    int fds[PERF_EVENTS];
+    std::string error;    // Why the first event that failed did not open
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const;                  // At least one event opened
+    bool isOpen(PerfEvent event) const { return fds[static_cast<int>(event)] >= 0; }
+    const std::string& getError() const { return error; }
+
+    // Counts from start() to stop(); a region is one benchmark phase, so
+    // the ioctls are paid once per phase
+    void start();
+    PerfReading stop();
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef PREFIX_BTREE_H
+#define PREFIX_BTREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Key compression switches for PrefixBTree
+struct PrefixBTreeConfig {
+    static const size_t DEFAULT_NODE_BYTES = 4096;
+
+    size_t node_bytes;         // Encoded size a node may reach before it splits
+    bool prefix_compression;   // Store the prefix shared by a node's keys once
+    bool suffix_truncation;    // Separators: shortest string that still routes correctly
+
+    PrefixBTreeConfig()
+        : node_bytes(DEFAULT_NODE_BYTES), prefix_compression(true), suffix_truncation(true) {}
+};
+
+// Node holding its keys as one shared prefix plus the remaining suffixes
+// packed back to back, the way they would sit in a page. Leaves hold the
+// records; internal nodes hold separators, with keys < separator on the
+// left and keys >= separator on the right.
+struct PrefixNode {
+    static const size_t HEADER_BYTES = 16;   // Leaf flag, key count, prefix length, next leaf
+
+    bool is_leaf;
+    std::string prefix;
+    std::string suffixes;                 // Packed suffix bytes
+    std::vector<uint32_t> ends;           // Suffix i is suffixes[ends[i-1], ends[i])
+    std::vector<PrefixNode*> children;    // Internal nodes only: numKeys() + 1
+    PrefixNode* next;                     // Leaves only: next leaf in key order
+
+    explicit PrefixNode(bool leaf) : is_leaf(leaf), next(nullptr) {}
+
+    size_t numKeys() const { return ends.size(); }
+    size_t suffixBegin(size_t i) const { return i == 0 ? 0 : ends[i - 1]; }
+    std::string key(size_t i) const;
+    std::vector<std::string> keys() const;
+    bool keyEquals(size_t i, const std::string& key) const;
+
+    // Size of the node written out as a page
+    size_t encodedBytes() const {
+        return HEADER_BYTES + prefix.size() + suffixes.size() + ends.size() * sizeof(uint32_t) +
+               children.size() * sizeof(uint64_t);
+    }
+
+    // Number of keys < key (lowerBound) or <= key (upperBound). A probe
+    // that does not share the node prefix is decided by the prefix alone.
+    size_t lowerBound(const std::string& key) const;
+    size_t upperBound(const std::string& key) const;
+
+    // Replace the contents with sorted keys[first, last)
+    void assign(const std::vector<std::string>& keys, size_t first, size_t last, bool compress);
+    void insertKey(size_t pos, const std::string& key, bool compress);
+};
+
+struct PrefixTreeStats {
+    size_t leaves;
+    size_t internal_nodes;
+    size_t encoded_bytes;      // All nodes, as pages would store them
+    size_t separator_bytes;    // Full length of the separators in internal nodes
+    double avg_leaf_keys;
+    double avg_fanout;         // Children per internal node
+};
+
+// B+tree for string keys in the style of Bayer & Unterauer's prefix
+// B-trees. Nodes split on encoded size, not key count, so whatever the
+// compression saves turns directly into fan-out: per-node prefix
+// compression stores a prefix like "/var/lib/docker/" once per node, and
+// suffix truncation promotes the shortest separator between two leaves
+// ("/usr/b" instead of "/usr/bin/zcat"), choosing the split point near
+// the middle that gives the shortest one. Set semantics: duplicates are
+// ignored.
+class PrefixBTree {
+private:
+    PrefixNode* root;
+    PrefixBTreeConfig config;
+    size_t num_keys;
+
+    bool insertInto(PrefixNode* node, const std::string& key, std::string& separator, PrefixNode*& sibling);
+    void splitNode(PrefixNode* node, std::string& separator, PrefixNode*& sibling);
+    std::string separatorBetween(const std::string& left, const std::string& right) const;
+    const PrefixNode* findLeaf(const std::string& key) const;
+    void destroy(PrefixNode* node);
+
+public:
+    explicit PrefixBTree(const PrefixBTreeConfig& treeConfig = PrefixBTreeConfig());
+    ~PrefixBTree();
+
+    PrefixBTree(const PrefixBTree&) = delete;
+    PrefixBTree& operator=(const PrefixBTree&) = delete;
+
+    void insert(const std::string& key);
+    bool search(const std::string& key) const;
+    std::vector<std::string> rangeScan(const std::string& lo, const std::string& hi) const;  // [lo, hi]
+
+    int getHeight() const;
+    size_t size() const { return num_keys; }
+    const PrefixBTreeConfig& getConfig() const { return config; }
+    PrefixTreeStats getStats() const;
+    PrefixNode* getRoot() { return root; }
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef RB_TREE_H
+#define RB_TREE_H
+
+#include <vector>
+#include <memory>
+#include "node_allocator.h"
+
+enum class RBColor : char { RED, BLACK };
+
+// Red-black tree node. The parent link lets the insert fix-up walk back
+// up the tree without recursion or a path stack.
+template <typename T>
+struct RBNode {
+    T key;
+    RBNode* left;
+    RBNode* right;
+    RBNode* parent;
+    RBColor color;
+
+    RBNode(T k, RBNode* p) : key(k), left(nullptr), right(nullptr), parent(p), color(RBColor::RED) {}
+};
+
+// Red-black tree (CLRS): no red node has a red child and every root-to-leaf
+// path has the same number of black nodes, so height <= 2 log2(n + 1).
+// Looser balance than AVL, but at most two rotations per insert. Same
+// set semantics as BST (duplicates are ignored). All operations iterative.
+template <typename T>
+class RBTree {
+private:
+    RBNode<T>* root;
+    size_t num_keys;
+    std::unique_ptr<NodeAllocator> allocator;
+
+    RBNode<T>* createNode(T key, RBNode<T>* parent);
+    void destroyNode(RBNode<T>* node);
+    void deleteTree();
+
+    void rotateLeft(RBNode<T>* node);
+    void rotateRight(RBNode<T>* node);
+    void insertFixup(RBNode<T>* node);
+
+public:
+    explicit RBTree(NodeAllocatorKind allocatorKind = NodeAllocatorKind::HEAP);
+    ~RBTree();
+
+    RBTree(const RBTree&) = delete;
+    RBTree& operator=(const RBTree&) = delete;
+
+    void insert(T key);
+    bool search(T key) const;
+    std::vector<T> rangeScan(T lo, T hi) const;    // All keys in [lo, hi], in order
+
+    int getHeight() const;
+    size_t size() const { return num_keys; }
+    RBNode<T>* getRoot() { return root; }
+    const NodeAllocator& getAllocator() const { return *allocator; }
+};
+
+#endif
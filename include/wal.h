@@ -0,0 +1,109 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <sys/types.h>
+
+// Log file layout:
+//
+//   +-------------------+-------------------------------+-----
+//   | WalFileHeader     | WalRecordHeader | payload ... | ...
+//   +-------------------+-------------------------------+-----
+//
+// Records carry consecutive LSNs. A checkpoint truncates the file back to
+// its header and stores the last LSN it covers there, so LSNs keep
+// increasing across checkpoints and restarts.
+struct WalFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t checkpoint_lsn;   // Every record up to here is in the data file
+};
+
+enum class WalRecordType : uint32_t {
+    INSERT = 1,      // Logical redo: payload is the key
+    PAGE_IMAGE = 2,  // Checkpoint double-write: PageId followed by the page bytes
+    CHECKPOINT = 3   // Every PAGE_IMAGE before this record is complete
+};
+
+struct WalRecordHeader {
+    uint64_t lsn;
+    uint32_t type;
+    uint32_t length;   // Payload bytes following the header
+    uint32_t crc;      // CRC-32 of this header (crc = 0) and the payload
+    uint32_t reserved;
+};
+
+static const uint32_t WAL_MAGIC = 0x57414C31;  // "WAL1"
+static const uint32_t WAL_VERSION = 1;
+
+// Append-only redo log with group commit. append() only buffers the
+// record; every group_commit records the buffer goes out in one write
+// followed by one fdatasync, so the fsync cost is shared by the whole
+// group. Until then the records are lost on a crash, which is the
+// durability the caller trades for throughput.
+//
+// Opening an existing log validates it record by record and cuts it at
+// the first torn or corrupt record, which is where a crash mid-write
+// leaves the tail.
+class WriteAheadLog {
+private:
+    int fd;
+    std::string path;
+    size_t group_commit;
+
+    std::vector<char> buffer;   // Records appended since the last commit
+    size_t buffered_records;
+    uint64_t next_lsn;
+    uint64_t durable_lsn;       // Last LSN known to be on disk
+    uint64_t checkpoint_lsn;
+    off_t end_offset;           // Where the next commit writes
+
+    long long records_appended;
+    long long syncs;
+    long long bytes_written;
+
+    void writeHeader();
+    bool readRecord(off_t offset, uint64_t expectedLsn, WalRecordHeader& header,
+                    std::vector<char>& payload) const;
+
+public:
+    // Opens (or creates) the log. If truncate is true, existing records are discarded.
+    WriteAheadLog(const std::string& filename, size_t groupCommit, bool truncate);
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Buffers a record and returns its LSN; commits once the group is full
+    uint64_t append(WalRecordType type, const void* payload, uint32_t length);
+
+    // Writes out buffered records and fdatasyncs the log
+    void commit();
+
+    // Drops every record: the caller has made them all durable elsewhere
+    void reset();
+
+    // Calls visit for every record after the last checkpoint, in LSN order.
+    // Returns the number of records visited.
+    size_t replay(const std::function<void(const WalRecordHeader&, const char*)>& visit) const;
+
+    void setGroupCommit(size_t groupCommit) { group_commit = groupCommit == 0 ? 1 : groupCommit; }
+    size_t getGroupCommit() const { return group_commit; }
+    uint64_t getLastLsn() const { return next_lsn - 1; }
+    uint64_t getDurableLsn() const { return durable_lsn; }
+    uint64_t getCheckpointLsn() const { return checkpoint_lsn; }
+    size_t getRecordsSinceCheckpoint() const { return static_cast<size_t>(next_lsn - 1 - checkpoint_lsn); }
+    off_t getFileBytes() const { return end_offset; }
+    const std::string& getPath() const { return path; }
+
+    long long getRecordsAppended() const { return records_appended; }
+    long long getSyncs() const { return syncs; }
+    long long getBytesWritten() const { return bytes_written; }
+    void resetStats() { records_appended = 0; syncs = 0; bytes_written = 0; }
+};
+
+#endif
@@ -0,0 +1,248 @@
+#include "async_page_reader.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+
+
+static int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+// The kernel reads the SQ tail and writes the CQ tail concurrently with us
+static unsigned loadAcquire(const unsigned* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void storeRelease(unsigned* p, unsigned value) {
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+AsyncPageReader::AsyncPageReader(PageFile& pageFile, unsigned queueDepth)
+    : file(pageFile), queue_depth(queueDepth), async(false),
+      ring_fd(-1), sq_ring(MAP_FAILED), cq_ring(MAP_FAILED), sqe_memory(MAP_FAILED),
+      sq_ring_bytes(0), cq_ring_bytes(0), sqe_bytes(0),
+      sq_head(nullptr), sq_tail(nullptr), sq_mask(nullptr), sq_array(nullptr),
+      cq_head(nullptr), cq_tail(nullptr), cq_mask(nullptr), cqes(nullptr),
+      buffers(nullptr), slots(2 * queueDepth), in_flight(0), unsubmitted(0),
+      reads(0), submits(0), total_latency_us(0.0), max_latency_us(0.0) {
+    if (queue_depth == 0) {
+        throw std::runtime_error("AsyncPageReader needs a queue depth of at least 1");
+    }
+
+    // Aligned, so the reads also work on an O_DIRECT file
+    void* memory = nullptr;
+    if (::posix_memalign(&memory, PageFile::IO_ALIGNMENT, slots.size() * file.getPageSize()) != 0) {
+        throw std::runtime_error("Cannot allocate async read buffers");
+    }
+    buffers = static_cast<char*>(memory);
+    for (unsigned i = 0; i < slots.size(); i++) {
+        free_slots.push_back(static_cast<unsigned>(slots.size()) - 1 - i);
+    }
+
+    // pread completes before read() returns, so there is never more than one in flight
+    async = setupRing();
+    if (!async) {
+        queue_depth = 1;
+    }
+}
+
+AsyncPageReader::~AsyncPageReader() {
+    // Reads still in flight would land in freed buffers, so drain them
+    if (async) {
+        try {
+            std::vector<PageReadCompletion> completed;
+            while (in_flight > 0) {
+                wait(completed);
+            }
+        } catch (const std::exception&) {
+        }
+    }
+    closeRing();
+    std::free(buffers);
+}
+
+// io_uring_setup, then map the submission ring, completion ring and SQE
+// array. Any failure leaves the reader on the pread fallback.
+bool AsyncPageReader::setupRing() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = ioUringSetup(queue_depth, &params);
+    if (ring_fd < 0) {
+        return false;
+    }
+
+    // IORING_OP_READ arrived in the same release as this feature bit
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        closeRing();
+        return false;
+    }
+
+    sq_ring_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqe_bytes = params.sq_entries * sizeof(io_uring_sqe);
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        sq_ring_bytes = cq_ring_bytes = std::max(sq_ring_bytes, cq_ring_bytes);
+    }
+
+    sq_ring = ::mmap(nullptr, sq_ring_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        closeRing();
+        return false;
+    }
+    if (singleMap) {
+        cq_ring = sq_ring;
+    } else {
+        cq_ring = ::mmap(nullptr, cq_ring_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            closeRing();
+            return false;
+        }
+    }
+    sqe_memory = ::mmap(nullptr, sqe_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ring_fd, IORING_OFF_SQES);
+    if (sqe_memory == MAP_FAILED) {
+        closeRing();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(sq_ring);
+    char* cq = static_cast<char*>(cq_ring);
+    sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = cq + params.cq_off.cqes;
+    return true;
+}
+
+void AsyncPageReader::closeRing() {
+    if (sqe_memory != MAP_FAILED) {
+        ::munmap(sqe_memory, sqe_bytes);
+        sqe_memory = MAP_FAILED;
+    }
+    if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+        ::munmap(cq_ring, cq_ring_bytes);
+    }
+    cq_ring = MAP_FAILED;
+    if (sq_ring != MAP_FAILED) {
+        ::munmap(sq_ring, sq_ring_bytes);
+        sq_ring = MAP_FAILED;
+    }
+    if (ring_fd >= 0) {
+        ::close(ring_fd);
+        ring_fd = -1;
+    }
+}
+
+void AsyncPageReader::read(PageId id, uint64_t tag) {
+    if (in_flight == queue_depth) {
+        throw std::runtime_error("AsyncPageReader queue is full");
+    }
+
+    unsigned slot = free_slots.back();
+    free_slots.pop_back();
+    slots[slot].page_id = id;
+    slots[slot].tag = tag;
+    slots[slot].issued = std::chrono::steady_clock::now();
+    in_flight++;
+
+    if (!async) {
+        file.readPage(id, slotData(slot));
+        ready.push_back(slot);
+        return;
+    }
+
+    // Only this thread advances the SQ tail, so a plain read of it is fine
+    unsigned tail = *sq_tail;
+    unsigned index = tail & *sq_mask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqe_memory) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = file.getDescriptor();
+    sqe->addr = reinterpret_cast<uint64_t>(slotData(slot));
+    sqe->len = static_cast<uint32_t>(file.getPageSize());
+    sqe->off = static_cast<uint64_t>(id) * file.getPageSize();
+    sqe->user_data = slot;
+    sq_array[index] = index;
+    storeRelease(sq_tail, tail + 1);
+    unsubmitted++;
+}
+
+void AsyncPageReader::complete(unsigned slot, std::vector<PageReadCompletion>& completed) {
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                          slots[slot].issued).count();
+    total_latency_us += us;
+    if (us > max_latency_us) {
+        max_latency_us = us;
+    }
+    reads++;
+    in_flight--;
+    delivered.push_back(slot);
+    completed.push_back(PageReadCompletion{slots[slot].tag, slotData(slot)});
+}
+
+void AsyncPageReader::wait(std::vector<PageReadCompletion>& completed) {
+    // The caller is done with the pages handed out last time
+    free_slots.insert(free_slots.end(), delivered.begin(), delivered.end());
+    delivered.clear();
+
+    if (!async) {
+        for (unsigned slot : ready) {
+            complete(slot, completed);
+        }
+        ready.clear();
+        return;
+    }
+    if (in_flight == 0) {
+        return;
+    }
+
+    // Submit and wait in one syscall, unless completions are already there
+    unsigned minComplete = (loadAcquire(cq_tail) == *cq_head) ? 1 : 0;
+    if (unsubmitted > 0 || minComplete > 0) {
+        int ret;
+        do {
+            ret = ioUringEnter(ring_fd, unsubmitted, minComplete, IORING_ENTER_GETEVENTS);
+        } while (ret < 0 && errno == EINTR);
+        if (ret < 0) {
+            throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+        }
+        unsubmitted -= static_cast<unsigned>(ret);
+        submits++;
+    }
+
+    unsigned head = *cq_head;
+    unsigned tail = loadAcquire(cq_tail);
+    for (; head != tail; head++) {
+        const io_uring_cqe* cqe = static_cast<const io_uring_cqe*>(cqes) + (head & *cq_mask);
+        unsigned slot = static_cast<unsigned>(cqe->user_data);
+        if (cqe->res != static_cast<int>(file.getPageSize())) {
+            storeRelease(cq_head, head + 1);
+            in_flight--;
+            free_slots.push_back(slot);
+            std::string reason = cqe->res < 0 ? std::strerror(-cqe->res) : "short read";
+            throw std::runtime_error("Async read of page " + std::to_string(slots[slot].page_id) + " in '" +
+                                     file.getPath() + "' failed: " + reason);
+        }
+        complete(slot, completed);
+    }
+    storeRelease(cq_head, head);
+}
@@ -0,0 +1,202 @@
+#include "avl_tree.h"
+#include <new>
+#include <type_traits>
+
+
+
+template <typename T>
+AVLTree<T>::AVLTree(NodeAllocatorKind allocatorKind)
+    : root(nullptr), num_keys(0),
+      allocator(makeNodeAllocator(allocatorKind, sizeof(AVLNode<T>), alignof(AVLNode<T>))) {}
+
+template <typename T>
+AVLTree<T>::~AVLTree() {
+    if (!allocator->releasesInBulk() || !std::is_trivially_destructible<T>::value) {
+        deleteTree();
+    }
+}
+
+// Post-order free with an explicit stack: pop a node, queue its children
+template <typename T>
+void AVLTree<T>::deleteTree() {
+    std::vector<AVLNode<T>*> stack;
+    if (root != nullptr) {
+        stack.push_back(root);
+    }
+    while (!stack.empty()) {
+        AVLNode<T>* node = stack.back();
+        stack.pop_back();
+        if (node->left != nullptr) stack.push_back(node->left);
+        if (node->right != nullptr) stack.push_back(node->right);
+        destroyNode(node);
+    }
+    root = nullptr;
+}
+
+template <typename T>
+AVLNode<T>* AVLTree<T>::createNode(T key) {
+    void* memory = allocator->allocate(sizeof(AVLNode<T>), alignof(AVLNode<T>));
+    return new (memory) AVLNode<T>(key);
+}
+
+template <typename T>
+void AVLTree<T>::destroyNode(AVLNode<T>* node) {
+    node->~AVLNode<T>();
+    allocator->deallocate(node, sizeof(AVLNode<T>));
+}
+
+
+// === Rotations ===
+
+template <typename T>
+void AVLTree<T>::updateHeight(AVLNode<T>* node) {
+    int left = heightOf(node->left);
+    int right = heightOf(node->right);
+    node->height = 1 + (left > right ? left : right);
+}
+
+template <typename T>
+AVLNode<T>* AVLTree<T>::rotateLeft(AVLNode<T>* node) {
+    AVLNode<T>* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+template <typename T>
+AVLNode<T>* AVLTree<T>::rotateRight(AVLNode<T>* node) {
+    AVLNode<T>* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+// Restore |balance| <= 1 at node; returns the new subtree root
+template <typename T>
+AVLNode<T>* AVLTree<T>::rebalance(AVLNode<T>* node) {
+    updateHeight(node);
+    int balance = heightOf(node->left) - heightOf(node->right);
+
+    if (balance > 1) {
+        if (heightOf(node->left->left) < heightOf(node->left->right)) {
+            node->left = rotateLeft(node->left);      // Left-right case
+        }
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        if (heightOf(node->right->right) < heightOf(node->right->left)) {
+            node->right = rotateRight(node->right);   // Right-left case
+        }
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+
+template <typename T>
+void AVLTree<T>::insert(T key) {
+    AVLNode<T>* path[MAX_HEIGHT];
+    int depth = 0;
+
+    // Descend, remembering every node on the way
+    AVLNode<T>* node = root;
+    while (node != nullptr) {
+        if (key < node->key) {
+            path[depth++] = node;
+            node = node->left;
+        } else if (node->key < key) {
+            path[depth++] = node;
+            node = node->right;
+        } else {
+            return;  // Duplicate
+        }
+    }
+
+    AVLNode<T>* child = createNode(key);
+    num_keys++;
+    if (depth == 0) {
+        root = child;
+        return;
+    }
+
+    // Retrace bottom-up. Once a subtree keeps its old height nothing
+    // above it can change, so stop there.
+    for (int i = depth - 1; i >= 0; i--) {
+        AVLNode<T>* parent = path[i];
+        if (key < parent->key) {
+            parent->left = child;
+        } else {
+            parent->right = child;
+        }
+
+        int oldHeight = parent->height;
+        child = rebalance(parent);
+
+        if (child != parent || child->height == oldHeight) {
+            // A rotation restores the pre-insert height, so only the link
+            // from the grandparent needs fixing
+            if (i == 0) {
+                root = child;
+            } else if (key < path[i - 1]->key) {
+                path[i - 1]->left = child;
+            } else {
+                path[i - 1]->right = child;
+            }
+            return;
+        }
+    }
+    root = child;
+}
+
+template <typename T>
+bool AVLTree<T>::search(T key) const {
+    const AVLNode<T>* node = root;
+    while (node != nullptr) {
+        if (key < node->key) {
+            node = node->left;
+        } else if (node->key < key) {
+            node = node->right;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Iterative in-order walk starting at the lower bound. The stack holds
+// ancestors we turned left at, i.e. keys not yet yielded.
+template <typename T>
+std::vector<T> AVLTree<T>::rangeScan(T lo, T hi) const {
+    std::vector<T> result;
+    std::vector<AVLNode<T>*> stack;
+
+    AVLNode<T>* node = root;
+    while (node != nullptr) {
+        if (node->key < lo) {
+            node = node->right;
+        } else {
+            stack.push_back(node);
+            node = node->left;
+        }
+    }
+
+    while (!stack.empty()) {
+        node = stack.back();
+        stack.pop_back();
+        if (hi < node->key) {
+            break;
+        }
+        result.push_back(node->key);
+        for (node = node->right; node != nullptr; node = node->left) {
+            stack.push_back(node);
+        }
+    }
+    return result;
+}
+
+
+template class AVLTree<int>;
@@ -0,0 +1,211 @@
+#include "b_plus_tree.h"
+#include <string>
+
+
+
+template <typename T>
+BPlusTreeNode<T>::BPlusTreeNode(int degree, bool leaf){
+	is_leaf = leaf;
+	next = nullptr;
+	keys.reserve(2 * degree - 1);
+
+	if(!is_leaf){
+		children.reserve(2 * degree);
+	}
+}
+
+template <typename T>
+BPlusTreeNode<T>::~BPlusTreeNode(){
+	for (auto child : children){
+		delete child;
+	}
+}
+
+template <typename T>
+BPlusTree<T>::~BPlusTree(){
+	if (root != nullptr){
+		delete root;
+	}
+}
+
+
+// Descend to the leftmost leaf that can hold a key >= key. Routing uses
+// "number of separators < key", so duplicates left of a separator are
+// not skipped.
+template <typename T>
+BPlusTreeNode<T>* BPlusTree<T>::findLeaf(T key) {
+    BPlusTreeNode<T>* node = root;
+    while (node != nullptr && !node->is_leaf) {
+        size_t i = 0;
+        while (i < node->keys.size() && node->keys[i] < key) {
+            i++;
+        }
+        node = node->children[i];
+    }
+    return node;
+}
+
+template <typename T>
+BPlusTreeIterator<T> BPlusTree<T>::lowerBound(T key) {
+    BPlusTreeNode<T>* leaf = findLeaf(key);
+    if (leaf == nullptr) {
+        return end();
+    }
+
+    size_t i = 0;
+    while (i < leaf->keys.size() && leaf->keys[i] < key) {
+        i++;
+    }
+    return iterator(leaf, i);
+}
+
+template <typename T>
+BPlusTreeIterator<T> BPlusTree<T>::begin() {
+    BPlusTreeNode<T>* node = root;
+    while (node != nullptr && !node->is_leaf) {
+        node = node->children[0];
+    }
+    return iterator(node, 0);
+}
+
+// Every search ends in a leaf: internal separators are not records
+template <typename T>
+bool BPlusTree<T>::search(T key) {
+    iterator it = lowerBound(key);
+    return it != end() && *it == key;
+}
+
+// Range scan: one descent, then a sequential walk along the leaf chain
+template <typename T>
+std::vector<T> BPlusTree<T>::rangeScan(T lo, T hi) {
+    std::vector<T> result;
+    for (iterator it = lowerBound(lo); it != end() && !(hi < *it); ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+
+// Split the full child at children[index] of parent.
+// Leaf:     right half moves to the new leaf, its first key is COPIED up.
+// Internal: like BtreeNode::splitChild, the middle separator MOVES up.
+template <typename T>
+void BPlusTree<T>::splitChild(BPlusTreeNode<T>* parent, int index, BPlusTreeNode<T>* child) {
+    BPlusTreeNode<T>* newNode = new BPlusTreeNode<T>(min_degree, child->is_leaf);
+    T separator;
+
+    if (child->is_leaf) {
+        // Left keeps t-1 keys, right gets t keys
+        newNode->keys.assign(child->keys.begin() + (min_degree - 1), child->keys.end());
+        child->keys.resize(min_degree - 1);
+        separator = newNode->keys[0];
+
+        // Splice the new leaf into the chain
+        newNode->next = child->next;
+        child->next = newNode;
+    } else {
+        separator = child->keys[min_degree - 1];
+        newNode->keys.assign(child->keys.begin() + min_degree, child->keys.end());
+        newNode->children.assign(child->children.begin() + min_degree, child->children.end());
+        child->keys.resize(min_degree - 1);
+        child->children.resize(min_degree);
+    }
+
+    parent->children.insert(parent->children.begin() + index + 1, newNode);
+    parent->keys.insert(parent->keys.begin() + index, separator);
+}
+
+// Top-down insert with proactive splits, same shape as BTree::insert
+template <typename T>
+void BPlusTree<T>::insert(T key) {
+    size_t max_keys = 2 * min_degree - 1;
+
+    // Case 1: Tree is empty
+    if (root == nullptr) {
+        root = new BPlusTreeNode<T>(min_degree, true);
+        root->keys.push_back(key);
+        return;
+    }
+
+    // Case 2: Root is full - grow the tree by one level
+    if (root->keys.size() == max_keys) {
+        BPlusTreeNode<T>* newRoot = new BPlusTreeNode<T>(min_degree, false);
+        newRoot->children.push_back(root);
+        splitChild(newRoot, 0, root);
+        root = newRoot;
+    }
+
+    BPlusTreeNode<T>* node = root;
+    while (!node->is_leaf) {
+        // Keys equal to a separator belong to its right subtree
+        size_t i = 0;
+        while (i < node->keys.size() && !(key < node->keys[i])) {
+            i++;
+        }
+
+        if (node->children[i]->keys.size() == max_keys) {
+            splitChild(node, i, node->children[i]);
+            if (!(key < node->keys[i])) {
+                i++;
+            }
+        }
+        node = node->children[i];
+    }
+
+    // Insert into the leaf after any equal keys
+    size_t pos = node->keys.size();
+    while (pos > 0 && key < node->keys[pos - 1]) {
+        pos--;
+    }
+    node->keys.insert(node->keys.begin() + pos, key);
+}
+
+
+template <typename T>
+void BPlusTree<T>::traverse() {
+    for (iterator it = begin(); it != end(); ++it) {
+        std::cout << *it << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Print tree structure with indentation showing levels
+template <typename T>
+void BPlusTreeNode<T>::printTree(int level) {
+    std::cout << std::string(level * 4, ' ');
+
+    std::cout << (is_leaf ? "[" : "<");
+    for (size_t i = 0; i < keys.size(); i++) {
+        std::cout << keys[i];
+        if (i < keys.size() - 1) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << (is_leaf ? "] (leaf)" : ">") << std::endl;
+
+    if (!is_leaf) {
+        for (size_t i = 0; i < children.size(); i++) {
+            children[i]->printTree(level + 1);
+        }
+    }
+}
+
+template <typename T>
+void BPlusTree<T>::printTree() {
+    if (root == nullptr) {
+        std::cout << "(empty tree)" << std::endl;
+        return;
+    }
+
+    std::cout << "\n=== B+Tree Structure ===" << std::endl;
+    root->printTree(0);
+    std::cout << "========================\n" << std::endl;
+}
+
+
+template class BPlusTree<int>;
+template class BPlusTreeNode<int>;
+template class BPlusTreeIterator<int>;
+template class BPlusTree<std::string>;
+template class BPlusTreeNode<std::string>;
+template class BPlusTreeIterator<std::string>;
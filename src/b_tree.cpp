@@ -1,4 +1,6 @@
 #include "b_tree.h"
+#include "instrumentation.h"
+#include <string>
 
 
 
@@ -44,12 +46,11 @@ void BtreeNode<T>::traverse(){
 
 
 template <typename T>
-BtreeNode<T>* BtreeNode<T>::search(T key) {
+BtreeNode<T>* BtreeNode<T>::search(T key, NodeSearchMode mode) {
     // Find the first key greater than or equal to the search key
-    size_t i = 0;
-    while (i < keys.size() && key > keys[i]) {
-        i++;
-    }
+    size_t i = nodeLowerBound(keys.data(), keys.size(), key, mode);
+    TREE_COUNT_NODE_VISIT();
+    TREE_COUNT_COMPARISONS(nodeSearchComparisons(keys.data(), keys.size(), i, mode) + (i < keys.size() ? 1 : 0));
     
     // If we found the key, return this node
     if (i < keys.size() && keys[i] == key) {
@@ -62,13 +63,76 @@ BtreeNode<T>* BtreeNode<T>::search(T key) {
     }
     
     // Recursively search in the appropriate child
-    return children[i]->search(key);
+    return children[i]->search(key, mode);
 }
 
 // BTree search: Start from root
 template <typename T>
 bool BTree<T>::search(T key) {
-    return (root == nullptr) ? false : (root->search(key) != nullptr);
+    return (root == nullptr) ? false : (root->search(key, search_mode) != nullptr);
+}
+
+
+// The probes reaching node are in key order, so one left-to-right pass
+// over its keys places them all: each lower bound starts where the
+// previous probe's ended. Runs of probes that route to the same child
+// are handed down together.
+template <typename T>
+size_t BTree<T>::searchBatchNode(BtreeNode<T>* node, const T* probes, const size_t* order,
+                                 size_t count, std::vector<bool>& found) {
+    size_t visits = 1;
+    const T* keys = node->keys.data();
+    size_t n = node->keys.size();
+
+    size_t pos = 0;
+    size_t run_start = 0;   // First probe of the pending run for child run_child
+    size_t run_child = 0;
+    for (size_t p = 0; p < count; p++) {
+        const T& key = probes[order[p]];
+        pos += nodeLowerBound(keys + pos, n - pos, key, search_mode);
+
+        bool hit = pos < n && keys[pos] == key;
+        if (hit) {
+            found[order[p]] = true;
+        }
+
+        if (node->is_leaf) {
+            continue;
+        }
+        if (hit || pos != run_child) {
+            if (p > run_start) {
+                visits += searchBatchNode(node->children[run_child], probes, order + run_start,
+                                          p - run_start, found);
+            }
+            run_start = hit ? p + 1 : p;
+            run_child = pos;
+        }
+    }
+
+    if (!node->is_leaf && count > run_start) {
+        visits += searchBatchNode(node->children[run_child], probes, order + run_start,
+                                  count - run_start, found);
+    }
+    return visits;
+}
+
+template <typename T>
+size_t BTree<T>::searchBatch(const T* probes, size_t count, std::vector<bool>& found, bool presorted) {
+    found.assign(count, false);
+    if (root == nullptr || count == 0) {
+        return 0;
+    }
+
+    // Sort an index permutation so results land back in caller order
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    if (!presorted) {
+        std::sort(order.begin(), order.end(),
+                  [probes](size_t a, size_t b) { return probes[a] < probes[b]; });
+    }
+    return searchBatchNode(root, probes, order.data(), count, found);
 }
 
 
@@ -91,6 +155,11 @@ void BtreeNode<T>::splitChild(int index, BtreeNode* child) {
     
     // The middle key will move up to this node
     T middleKey = child->keys[min_degree - 1];
+    TREE_COUNT_SPLIT();
+    TREE_COUNT_BYTES_MOVED((min_degree - 1) * sizeof(T) +
+                           (child->is_leaf ? 0 : min_degree * sizeof(BtreeNode*)) +
+                           (keys.size() - index) * sizeof(T) +
+                           (children.size() - index - 1) * sizeof(BtreeNode*));
     
     // Reduce child's size
     child->keys.resize(min_degree - 1);
@@ -114,49 +183,41 @@ void BtreeNode<T>::splitChild(int index, BtreeNode* child) {
 
 
 template <typename T>
-void BtreeNode<T>::insertNonFull(T key) {
-    size_t i = keys.size() - 1;  // Start from rightmost key
+void BtreeNode<T>::insertNonFull(T key, NodeSearchMode mode) {
+    // Position after the last key <= key (duplicates keep insertion order)
+    size_t i = nodeUpperBound(keys.data(), keys.size(), key, mode);
+    TREE_COUNT_NODE_VISIT();
+    TREE_COUNT_COMPARISONS(nodeSearchComparisons(keys.data(), keys.size(), i, mode));
     
     if (is_leaf) {
         // This is a leaf node - insert directly
-        keys.push_back(T());  // Make space
-        
-        // Shift keys to make room for new key
-        while (i >= 0 && keys[i] > key) {
-            keys[i + 1] = keys[i];
-            i--;
-        }
-        
-        // Insert the key
-        keys[i + 1] = key;
+        TREE_COUNT_BYTES_MOVED((keys.size() - i) * sizeof(T));
+        keys.insert(keys.begin() + i, key);
     } 
     else {
-        // This is an internal node - find which child to insert into
-        
-        // Find the child where key should go
-        while (i >= 0 && keys[i] > key) {
-            i--;
-        }
-        i++;  // Now children[i] is the correct child
+        // This is an internal node - children[i] is the child to insert into
         
         // Check if the child is full
-        if (children[i]->keys.size() == (2 * min_degree - 1)) {
+        if (children[i]->keys.size() == static_cast<size_t>(2 * min_degree - 1)) {
             // Child is full, split it first
             splitChild(i, children[i]);
             
             // After split, decide which of the two children to use
+            TREE_COUNT_COMPARISONS(1);
             if (keys[i] < key) {
                 i++;
             }
         }
         
         // Recursively insert into the appropriate child
-        children[i]->insertNonFull(key);
+        children[i]->insertNonFull(key, mode);
     }
 }
 
 template <typename T>
 void BTree<T>::insert(T key) {
+    num_keys++;
+
     // Case 1: Tree is empty
     if (root == nullptr) {
         root = new BtreeNode<T>(min_degree, true);
@@ -165,7 +226,7 @@ void BTree<T>::insert(T key) {
     }
     
     // Case 2: Root is full - need to split root
-    if (root->keys.size() == (2 * min_degree - 1)) {
+    if (root->keys.size() == static_cast<size_t>(2 * min_degree - 1)) {
         // Create new root
         BtreeNode<T>* newRoot = new BtreeNode<T>(min_degree, false);
         
@@ -177,17 +238,18 @@ void BTree<T>::insert(T key) {
         
         // New root has 2 children now, decide which one gets the key
         size_t i = 0;
+        TREE_COUNT_COMPARISONS(1);
         if (newRoot->keys[0] < key) {
             i++;
         }
-        newRoot->children[i]->insertNonFull(key);
+        newRoot->children[i]->insertNonFull(key, search_mode);
         
         // Update root
         root = newRoot;
     }
     // Case 3: Root is not full
     else {
-        root->insertNonFull(key);
+        root->insertNonFull(key, search_mode);
     }
 }
 
@@ -195,6 +257,357 @@ void BTree<T>::insert(T key) {
 
 
 
+// === Deletion ===
+// Top-down like insert: before descending into a child, make sure it has
+// at least min_degree keys (borrow from a sibling or merge with one), so
+// removing a key from it can never leave it below the minimum.
+
+template <typename T>
+bool BtreeNode<T>::remove(T key, NodeSearchMode mode) {
+    size_t i = nodeLowerBound(keys.data(), keys.size(), key, mode);
+
+    if (i < keys.size() && keys[i] == key) {
+        if (is_leaf) {
+            // Case 1: key is in this leaf
+            keys.erase(keys.begin() + i);
+        } else {
+            // Case 2: key is in this internal node
+            removeFromInternal(i, mode);
+        }
+        return true;
+    }
+
+    if (is_leaf) {
+        return false;
+    }
+
+    // Case 3: key can only be in the subtree children[i]
+    bool last_child = (i == keys.size());
+    if (children[i]->keys.size() < static_cast<size_t>(min_degree)) {
+        fill(i);
+    }
+
+    // If the last child was merged into its left sibling, follow it there
+    if (last_child && i > keys.size()) {
+        return children[i - 1]->remove(key, mode);
+    }
+    return children[i]->remove(key, mode);
+}
+
+// Replace keys[index] with its predecessor or successor taken from a child
+// that can spare one; if neither can, merge the two around it and recurse
+template <typename T>
+void BtreeNode<T>::removeFromInternal(size_t index, NodeSearchMode mode) {
+    T key = keys[index];
+
+    if (children[index]->keys.size() >= static_cast<size_t>(min_degree)) {
+        T predecessor = children[index]->maxKey();
+        keys[index] = predecessor;
+        children[index]->remove(predecessor, mode);
+    } else if (children[index + 1]->keys.size() >= static_cast<size_t>(min_degree)) {
+        T successor = children[index + 1]->minKey();
+        keys[index] = successor;
+        children[index + 1]->remove(successor, mode);
+    } else {
+        merge(index);
+        children[index]->remove(key, mode);
+    }
+}
+
+template <typename T>
+T BtreeNode<T>::maxKey() {
+    BtreeNode* node = this;
+    while (!node->is_leaf) {
+        node = node->children.back();
+    }
+    return node->keys.back();
+}
+
+template <typename T>
+T BtreeNode<T>::minKey() {
+    BtreeNode* node = this;
+    while (!node->is_leaf) {
+        node = node->children.front();
+    }
+    return node->keys.front();
+}
+
+// Give children[index] at least min_degree keys
+template <typename T>
+void BtreeNode<T>::fill(size_t index) {
+    if (index > 0 && children[index - 1]->keys.size() >= static_cast<size_t>(min_degree)) {
+        borrowFromPrev(index);
+    } else if (index < keys.size() && children[index + 1]->keys.size() >= static_cast<size_t>(min_degree)) {
+        borrowFromNext(index);
+    } else if (index < keys.size()) {
+        merge(index);
+    } else {
+        merge(index - 1);
+    }
+}
+
+// Rotate right: separator moves down into the child, the left sibling's
+// last key moves up to replace it
+template <typename T>
+void BtreeNode<T>::borrowFromPrev(size_t index) {
+    BtreeNode* child = children[index];
+    BtreeNode* sibling = children[index - 1];
+
+    child->keys.insert(child->keys.begin(), keys[index - 1]);
+    if (!child->is_leaf) {
+        child->children.insert(child->children.begin(), sibling->children.back());
+        sibling->children.pop_back();
+    }
+
+    keys[index - 1] = sibling->keys.back();
+    sibling->keys.pop_back();
+}
+
+// Rotate left: mirror image of borrowFromPrev
+template <typename T>
+void BtreeNode<T>::borrowFromNext(size_t index) {
+    BtreeNode* child = children[index];
+    BtreeNode* sibling = children[index + 1];
+
+    child->keys.push_back(keys[index]);
+    if (!child->is_leaf) {
+        child->children.push_back(sibling->children.front());
+        sibling->children.erase(sibling->children.begin());
+    }
+
+    keys[index] = sibling->keys.front();
+    sibling->keys.erase(sibling->keys.begin());
+}
+
+// Fold children[index + 1] and the separator between them into
+// children[index]. Both hold fewer than min_degree keys, so the result
+// fits in one node.
+template <typename T>
+void BtreeNode<T>::merge(size_t index) {
+    BtreeNode* child = children[index];
+    BtreeNode* sibling = children[index + 1];
+
+    child->keys.push_back(keys[index]);
+    child->keys.insert(child->keys.end(), sibling->keys.begin(), sibling->keys.end());
+    if (!child->is_leaf) {
+        child->children.insert(child->children.end(), sibling->children.begin(), sibling->children.end());
+    }
+
+    sibling->children.clear();  // Now owned by child
+    delete sibling;
+
+    keys.erase(keys.begin() + index);
+    children.erase(children.begin() + index + 1);
+}
+
+// A merge at the root can leave it without keys: drop a level
+template <typename T>
+void BTree<T>::shrinkRoot() {
+    if (root == nullptr || !root->keys.empty()) {
+        return;
+    }
+    BtreeNode<T>* old_root = root;
+    if (root->is_leaf) {
+        root = nullptr;
+    } else {
+        root = root->children[0];
+        old_root->children.clear();
+    }
+    delete old_root;
+}
+
+// Leaf hit that leaves at least one key behind: erase in place with no
+// rebalancing. Anything else (key in an internal node, last key of a
+// leaf) takes the eager path, which copes with underfull nodes.
+template <typename T>
+bool BTree<T>::removeLazy(T key) {
+    BtreeNode<T>* node = root;
+    while (true) {
+        size_t i = nodeLowerBound(node->keys.data(), node->keys.size(), key, search_mode);
+        if (i < node->keys.size() && node->keys[i] == key) {
+            if (node->is_leaf && (node->keys.size() > 1 || node == root)) {
+                node->keys.erase(node->keys.begin() + i);
+                return true;
+            }
+            return root->remove(key, search_mode);
+        }
+        if (node->is_leaf) {
+            return false;
+        }
+        node = node->children[i];
+    }
+}
+
+template <typename T>
+bool BTree<T>::remove(T key) {
+    if (root == nullptr) {
+        return false;
+    }
+
+    bool removed = (delete_mode == DeleteMode::LAZY) ? removeLazy(key)
+                                                      : root->remove(key, search_mode);
+    shrinkRoot();
+    if (!removed) {
+        return false;
+    }
+    num_keys--;
+
+    if (delete_mode == DeleteMode::LAZY &&
+        ++lazy_deletes > static_cast<size_t>(rebalance_ratio * num_keys)) {
+        rebalance();
+    }
+    return true;
+}
+
+// Batch rebalance: one in-order pass, then a bottom-up rebuild
+template <typename T>
+void BTree<T>::rebalance(double fill_factor) {
+    std::vector<T> sorted;
+    sorted.reserve(num_keys);
+    for (iterator it = begin(); it != end(); ++it) {
+        sorted.push_back(*it);
+    }
+    bulkLoadSorted(sorted, fill_factor);
+}
+
+template <typename T>
+double BTree<T>::fillFactor() {
+    if (root == nullptr) {
+        return 0.0;
+    }
+
+    size_t nodes = 0;
+    size_t keys = 0;
+    std::vector<BtreeNode<T>*> stack(1, root);
+    while (!stack.empty()) {
+        BtreeNode<T>* node = stack.back();
+        stack.pop_back();
+        nodes++;
+        keys += node->keys.size();
+        if (!node->is_leaf) {
+            stack.insert(stack.end(), node->children.begin(), node->children.end());
+        }
+    }
+    return static_cast<double>(keys) / (nodes * (2 * min_degree - 1));
+}
+
+
+// Bottom-up build. Each level is cut into nodes of ~fill_factor occupancy
+// with one separator between neighbours; the separators become the items
+// of the level above, until everything fits in a single root. Keys are
+// spread evenly so no node ends up below the (min_degree-1) minimum.
+template <typename T>
+void BTree<T>::bulkLoadSorted(const std::vector<T>& sorted, double fill_factor) {
+    delete root;
+    root = nullptr;
+    num_keys = sorted.size();
+    lazy_deletes = 0;
+    if (sorted.empty()) {
+        return;
+    }
+
+    size_t min_keys = min_degree - 1;
+    size_t max_keys = 2 * min_degree - 1;
+    size_t target = static_cast<size_t>(fill_factor * max_keys + 0.5);
+    target = std::max(min_keys, std::min(max_keys, target));
+    if (target == 0) {
+        target = 1;
+    }
+
+    std::vector<T> items = sorted;
+    std::vector<BtreeNode<T>*> below;  // Nodes of the level underneath
+    bool leaf = true;
+
+    while (true) {
+        size_t n = items.size();
+
+        // Number of nodes on this level: each holds ~target keys and
+        // every boundary between two nodes consumes one separator
+        size_t count = 1;
+        if (n > max_keys) {
+            count = (n + 1 + target) / (target + 1);  // ceil((n+1)/(target+1))
+            while (count > 1 && (n - (count - 1)) / count < min_keys) {
+                count--;
+            }
+            while ((n - (count - 1) + count - 1) / count > max_keys) {
+                count++;
+            }
+        }
+
+        size_t keys_per_node = (n - (count - 1)) / count;
+        size_t extra = (n - (count - 1)) % count;
+
+        std::vector<BtreeNode<T>*> level;
+        std::vector<T> separators;
+        level.reserve(count);
+        separators.reserve(count - 1);
+
+        size_t pos = 0;
+        size_t child = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t take = keys_per_node + (i < extra ? 1 : 0);
+            BtreeNode<T>* node = new BtreeNode<T>(min_degree, leaf);
+
+            node->keys.assign(items.begin() + pos, items.begin() + pos + take);
+            pos += take;
+            if (!leaf) {
+                node->children.assign(below.begin() + child, below.begin() + child + take + 1);
+                child += take + 1;
+            }
+            level.push_back(node);
+
+            if (i + 1 < count) {
+                separators.push_back(items[pos++]);
+            }
+        }
+
+        if (count == 1) {
+            root = level[0];
+            return;
+        }
+
+        items.swap(separators);
+        below.swap(level);
+        leaf = false;
+    }
+}
+
+// Iterator positioned at the smallest key
+template <typename T>
+BTreeIterator<T> BTree<T>::begin() {
+    iterator it;
+    it.descendLeftmost(root);
+    it.settle();
+    return it;
+}
+
+// Iterator positioned at the first key >= key. Each frame on the way down
+// remembers which child we entered, so the parent key is yielded next.
+template <typename T>
+BTreeIterator<T> BTree<T>::lowerBound(T key) {
+    iterator it;
+    BtreeNode<T>* node = root;
+    while (node != nullptr) {
+        size_t i = nodeLowerBound(node->keys.data(), node->keys.size(), key, search_mode);
+        it.path.push_back(typename iterator::Frame{node, i});
+        node = node->is_leaf ? nullptr : node->children[i];
+    }
+    it.settle();
+    return it;
+}
+
+// Range scan: one descent to the lower bound, then an in-order walk
+template <typename T>
+std::vector<T> BTree<T>::rangeScan(T lo, T hi) {
+    std::vector<T> result;
+    for (iterator it = lowerBound(lo); it != end() && !(hi < *it); ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+
+
 template <typename T>
 void BTree<T>::traverse() {
     if (root != nullptr) {
@@ -250,3 +663,7 @@ void BTree<T>::printTree() {
 
 template class BTree<int>;
 template class BtreeNode<int>;
+template class BTreeIterator<int>;
+template class BTree<std::string>;
+template class BtreeNode<std::string>;
+template class BTreeIterator<std::string>;
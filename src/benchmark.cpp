@@ -0,0 +1,501 @@
+#include "benchmark.h"
+#include "b_tree.h"
+#include "b_plus_tree.h"
+#include "fixed_b_tree.h"
+#include "bst.h"
+#include "avl_tree.h"
+#include "rb_tree.h"
+#include <iostream>
+#include <sstream>
+
+
+
+std::string benchmarkPhaseName(BenchmarkPhase phase) {
+    switch (phase) {
+        case BenchmarkPhase::INSERT:     return "Insert";
+        case BenchmarkPhase::SEARCH:     return "Search";
+        case BenchmarkPhase::RANGE_100:  return "Range100";
+        case BenchmarkPhase::RANGE_10K:  return "Range10K";
+        case BenchmarkPhase::RANGE_FULL: return "RangeFull";
+    }
+    return "Unknown";
+}
+
+typedef std::chrono::high_resolution_clock HarnessClock;
+
+static long long elapsedNs(HarnessClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(HarnessClock::now() - start).count();
+}
+
+// Samples are taken in nanoseconds so that short scans keep their precision
+static TimingSummary summarize(const std::vector<long long>& samplesNs) {
+    TimingSummary summary;
+    double mean = Statistics::mean(samplesNs);
+    double halfWidth = Statistics::confidence95(samplesNs);
+
+    summary.samples = samplesNs.size();
+    summary.mean_us = mean / 1000.0;
+    summary.median_us = Statistics::median(samplesNs) / 1000.0;
+    summary.stddev_us = Statistics::stddev(samplesNs) / 1000.0;
+    summary.min_us = Statistics::min(samplesNs) / 1000.0;
+    summary.max_us = Statistics::max(samplesNs) / 1000.0;
+    summary.ci95_low_us = (mean - halfWidth) / 1000.0;
+    summary.ci95_high_us = (mean + halfWidth) / 1000.0;
+    return summary;
+}
+
+BenchmarkHarness::BenchmarkHarness(const HarnessConfig& harnessConfig) : config(harnessConfig) {
+    if (config.repetitions < 1 || config.min_repetitions < 1 || config.warmup_runs < 0) {
+        throw std::runtime_error("Benchmark harness needs at least one repetition");
+    }
+    if (config.min_repetitions > config.repetitions) {
+        config.min_repetitions = config.repetitions;
+    }
+
+    if (config.perf_counters) {
+        perf.reset(new PerfCounters());
+        if (!perf->available()) {
+            std::cerr << "Warning: hardware counters unavailable (" << perf->getError()
+                      << "), continuing without them" << std::endl;
+            perf.reset();
+            config.perf_counters = false;
+        } else if (!perf->getError().empty()) {
+            std::cerr << "Warning: some hardware counters unavailable (" << perf->getError()
+                      << "), their columns are -1" << std::endl;
+        }
+    }
+}
+
+void BenchmarkHarness::registerEngine(const std::string& name, const EngineFactory& factory) {
+    engines.push_back(std::make_pair(name, factory));
+}
+
+void BenchmarkHarness::registerWorkload(const std::string& name, const WorkloadGenerator& generator) {
+    workloads.push_back(std::make_pair(name, generator));
+}
+
+void BenchmarkHarness::registerScenarioWorkloads() {
+    registerWorkload("Sequential", [](int size) { return DataGenerator::sequential(size); });
+    registerWorkload("Random", [](int size) { return DataGenerator::random(size); });
+    registerWorkload("Reverse", [](int size) { return DataGenerator::reverse(size); });
+    registerWorkload("DuplicateHeavy", [](int size) { return DataGenerator::duplicateHeavy(size); });
+    registerWorkload("Skewed", [](int size) { return DataGenerator::skewed(size); });
+}
+
+void registerDefaultEngines(BenchmarkHarness& harness, int btreeDegree) {
+    harness.registerEngine("BTree", makeEngineFactory<BTree<int>>(
+        [btreeDegree]() { return new BTree<int>(btreeDegree); },
+        [](BTree<int>& t) { return calculateBTreeHeight(t.getRoot()); }));
+    harness.registerEngine("BPlusTree", makeEngineFactory<BPlusTree<int>>(
+        [btreeDegree]() { return new BPlusTree<int>(btreeDegree); },
+        [](BPlusTree<int>& t) { return calculateBPlusTreeHeight(t.getRoot()); }));
+    harness.registerEngine("FixedBTree", makeEngineFactory<FixedBTree<int, BENCH_BTREE_DEGREE>>(
+        []() { return new FixedBTree<int, BENCH_BTREE_DEGREE>(); },
+        [](FixedBTree<int, BENCH_BTREE_DEGREE>& t) { return t.getHeight(); }));
+    harness.registerEngine("BST", makeEngineFactory<BST<int>>(
+        []() { return new BST<int>(); },
+        [](BST<int>& t) { return calculateBSTHeight(t.getRoot()); }));
+    harness.registerEngine("AVL", makeEngineFactory<AVLTree<int>>(
+        []() { return new AVLTree<int>(); },
+        [](AVLTree<int>& t) { return t.getHeight(); }));
+    harness.registerEngine("RedBlack", makeEngineFactory<RBTree<int>>(
+        []() { return new RBTree<int>(); },
+        [](RBTree<int>& t) { return t.getHeight(); }));
+}
+
+std::vector<std::string> BenchmarkHarness::getEngineNames() const {
+    std::vector<std::string> names;
+    for (const auto& engine : engines) {
+        names.push_back(engine.first);
+    }
+    return names;
+}
+
+
+// === Measurement ===
+
+// A single 100-key scan takes a few microseconds, below what one clock
+// read can resolve reliably, so scans are repeated until the batch runs
+// for at least a millisecond and the sample is the time per scan
+static const long long MIN_SCAN_BATCH_NS = 1000000;
+static const int MAX_SCAN_BATCH = 10000;
+
+void BenchmarkHarness::startCounters(CounterTotals* totals) {
+    if (totals != nullptr && perf) {
+        perf->start();
+    }
+}
+
+void BenchmarkHarness::stopCounters(CounterTotals* totals, BenchmarkPhase phase, double operations) {
+    if (totals == nullptr || !perf) {
+        return;
+    }
+    PerfReading reading = perf->stop();
+    int p = static_cast<int>(phase);
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        totals->events[p][e] += reading.values[e];
+        totals->valid[p][e] = totals->valid[p][e] && reading.valid[e];
+    }
+    totals->operations[p] += operations;
+}
+
+// Counters are started before and read after the clock, so the ioctls
+// stay out of the timings
+void BenchmarkHarness::runPass(const EngineFactory& factory, const std::vector<int>& data,
+                               const std::pair<int, int>* scanRanges, std::vector<long long>* samples,
+                               int& height, LatencyHistogram* insertLatencies,
+                               LatencyHistogram* searchLatencies, CounterTotals* counterTotals,
+                               TreeOpCounters* accessCounts) {
+    std::unique_ptr<TreeEngine> engine = factory();
+
+    resetTreeOpCounters();
+    startCounters(counterTotals);
+    auto start = HarnessClock::now();
+    if (insertLatencies != nullptr) {
+        engine->insertAll(data, *insertLatencies);
+    } else {
+        engine->insertAll(data);
+    }
+    samples[static_cast<int>(BenchmarkPhase::INSERT)].push_back(elapsedNs(start));
+    stopCounters(counterTotals, BenchmarkPhase::INSERT, data.size());
+    if (accessCounts != nullptr) {
+        accessCounts[static_cast<int>(BenchmarkPhase::INSERT)] = readTreeOpCounters();
+    }
+
+    resetTreeOpCounters();
+    startCounters(counterTotals);
+    start = HarnessClock::now();
+    volatile size_t found = searchLatencies != nullptr ? engine->searchAll(data, *searchLatencies)
+                                                       : engine->searchAll(data);
+    samples[static_cast<int>(BenchmarkPhase::SEARCH)].push_back(elapsedNs(start));
+    stopCounters(counterTotals, BenchmarkPhase::SEARCH, data.size());
+    if (accessCounts != nullptr) {
+        accessCounts[static_cast<int>(BenchmarkPhase::SEARCH)] = readTreeOpCounters();
+    }
+    (void)found;
+
+    for (int r = 0; r < 3; r++) {
+        BenchmarkPhase phase = static_cast<BenchmarkPhase>(static_cast<int>(BenchmarkPhase::RANGE_100) + r);
+        size_t returned = 0;
+        int scans = 0;
+        long long elapsed = 0;
+        startCounters(counterTotals);
+        start = HarnessClock::now();
+        do {
+            returned += engine->rangeScan(scanRanges[r].first, scanRanges[r].second);
+            scans++;
+            elapsed = elapsedNs(start);
+        } while (elapsed < MIN_SCAN_BATCH_NS && scans < MAX_SCAN_BATCH);
+        samples[static_cast<int>(phase)].push_back(elapsed / scans);
+        stopCounters(counterTotals, phase, returned);
+        volatile size_t sink = returned;
+        (void)sink;
+    }
+
+    height = engine->height();
+}
+
+// Warmup passes fault in the allocator's pages and train the caches and
+// branch predictors; their timings are dropped. The warmup also sizes the
+// case: measured passes are cut back (never below min_repetitions) so the
+// case stays near its time budget. The latency pass comes last and is not
+// a timing sample (its clock reads inflate the totals), except when a
+// warmup alone blows the budget: then it is the only pass measured.
+CaseResult BenchmarkHarness::runCase(const std::string& engineName, const std::string& workload,
+                                     const std::vector<int>& data) {
+    const EngineFactory* factory = nullptr;
+    for (const auto& engine : engines) {
+        if (engine.first == engineName) {
+            factory = &engine.second;
+        }
+    }
+    if (factory == nullptr) {
+        throw std::runtime_error("No benchmark engine registered as '" + engineName + "'");
+    }
+
+    std::pair<int, int> scanRanges[] = {
+        RangeWorkload::bounds(data, 100),
+        RangeWorkload::bounds(data, 10000),
+        RangeWorkload::full(data)
+    };
+
+    std::vector<long long> samples[BENCHMARK_PHASES];
+    int height = 0;
+    int repetitions = config.repetitions;
+
+    bool overBudget = false;
+
+    for (int w = 0; w < config.warmup_runs; w++) {
+        std::vector<long long> warmup[BENCHMARK_PHASES];
+        auto start = HarnessClock::now();
+        runPass(*factory, data, scanRanges, warmup, height);
+        long long passUs = elapsedNs(start) / 1000;
+
+        if (w + 1 == config.warmup_runs) {
+            if (passUs >= config.case_budget_us) {
+                overBudget = true;
+                repetitions = 0;
+            } else {
+                long long affordable = config.case_budget_us / std::max(1LL, passUs);
+                repetitions = static_cast<int>(std::max<long long>(config.min_repetitions,
+                                               std::min<long long>(config.repetitions, affordable)));
+            }
+        }
+    }
+
+    CounterTotals counterTotals;
+    for (int p = 0; p < BENCHMARK_PHASES; p++) {
+        counterTotals.operations[p] = 0;
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            counterTotals.events[p][e] = 0;
+            counterTotals.valid[p][e] = true;
+        }
+    }
+
+    for (int r = 0; r < repetitions; r++) {
+        runPass(*factory, data, scanRanges, samples, height, nullptr, nullptr, &counterTotals);
+    }
+
+    LatencyHistogram insertLatencies;
+    LatencyHistogram searchLatencies;
+    std::vector<long long> latencyPass[BENCHMARK_PHASES];
+    TreeOpCounters accessCounts[BENCHMARK_PHASES] = {};   // Same in every pass, so read once
+    runPass(*factory, data, scanRanges, overBudget ? samples : latencyPass, height,
+            &insertLatencies, &searchLatencies, overBudget ? &counterTotals : nullptr, accessCounts);
+
+    CaseResult result;
+    result.engine = engineName;
+    result.workload = workload;
+    result.num_elements = static_cast<int>(data.size());
+    result.tree_height = height;
+    result.repetitions = static_cast<int>(samples[0].size());
+    for (int p = 0; p < BENCHMARK_PHASES; p++) {
+        result.phases[p] = summarize(samples[p]);
+        for (int e = 0; e < PERF_EVENTS; e++) {
+            bool counted = perf && counterTotals.valid[p][e] && counterTotals.operations[p] > 0;
+            result.counters[p].per_op[e] = counted ? counterTotals.events[p][e] / counterTotals.operations[p] : -1.0;
+        }
+
+        // Every instrumented insert or lookup visits at least one node
+        const TreeOpCounters& a = accessCounts[p];
+        double keys = static_cast<double>(data.size());
+        bool counted = TREE_INSTRUMENTED && a.nodes_visited > 0;
+        result.accesses[p].nodes_visited = counted ? a.nodes_visited / keys : -1.0;
+        result.accesses[p].key_comparisons = counted ? a.key_comparisons / keys : -1.0;
+        result.accesses[p].node_splits = counted ? a.node_splits / keys : -1.0;
+        result.accesses[p].bytes_moved = counted ? a.bytes_moved / keys : -1.0;
+    }
+    result.insert_latency = summarizeLatency(insertLatencies);
+    result.search_latency = summarizeLatency(searchLatencies);
+    return result;
+}
+
+std::vector<CaseResult> BenchmarkHarness::runAll(const std::vector<int>& sizes,
+                                                 const std::function<void(size_t, size_t)>& progress) {
+    std::vector<CaseResult> results;
+    size_t total = sizes.size() * workloads.size() * engines.size();
+    size_t done = 0;
+
+    for (int size : sizes) {
+        for (const auto& workload : workloads) {
+            std::vector<int> data = workload.second(size);
+            for (const auto& engine : engines) {
+                results.push_back(runCase(engine.first, workload.first, data));
+                if (progress) {
+                    progress(++done, total);
+                }
+            }
+        }
+    }
+    return results;
+}
+
+
+// === Export ===
+
+LatencySummary BenchmarkHarness::summarizeLatency(const LatencyHistogram& histogram) {
+    LatencySummary summary;
+    summary.operations = histogram.count();
+    summary.mean_ns = histogram.mean();
+    summary.p50_ns = histogram.percentile(0.50);
+    summary.p99_ns = histogram.percentile(0.99);
+    summary.p999_ns = histogram.percentile(0.999);
+    summary.max_ns = histogram.max();
+    return summary;
+}
+
+void BenchmarkHarness::exportCSV(const std::vector<CaseResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return;
+    }
+
+    file << "Engine,Workload,NumElements,Phase,Repetitions,Mean_us,Median_us,Stddev_us,"
+         << "Min_us,Max_us,CI95Low_us,CI95High_us,TreeHeight";
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        file << "," << perfEventName(static_cast<PerfEvent>(e)) << "_per_op";
+    }
+    file << ",NodesVisited_per_op,Comparisons_per_op,Splits_per_op,BytesMoved_per_op\n";
+    for (const auto& result : results) {
+        for (int p = 0; p < BENCHMARK_PHASES; p++) {
+            const TimingSummary& s = result.phases[p];
+            file << result.engine << ","
+                 << result.workload << ","
+                 << result.num_elements << ","
+                 << benchmarkPhaseName(static_cast<BenchmarkPhase>(p)) << ","
+                 << s.samples << ","
+                 << s.mean_us << ","
+                 << s.median_us << ","
+                 << s.stddev_us << ","
+                 << s.min_us << ","
+                 << s.max_us << ","
+                 << s.ci95_low_us << ","
+                 << s.ci95_high_us << ","
+                 << result.tree_height;
+            for (int e = 0; e < PERF_EVENTS; e++) {
+                file << "," << result.counters[p].per_op[e];
+            }
+            const AccessCounts& a = result.accesses[p];
+            file << "," << a.nodes_visited << "," << a.key_comparisons << ","
+                 << a.node_splits << "," << a.bytes_moved << "\n";
+        }
+    }
+
+    file.close();
+    std::cout << "✅ Exported harness results to: " << filename << std::endl;
+}
+
+void BenchmarkHarness::exportLatencyCSV(const std::vector<CaseResult>& results, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return;
+    }
+
+    file << "Engine,Workload,NumElements,Operation,Operations,Mean_ns,P50_ns,P99_ns,P999_ns,Max_ns\n";
+    for (const auto& result : results) {
+        const LatencySummary* latencies[] = {&result.insert_latency, &result.search_latency};
+        const char* operations[] = {"Insert", "Search"};
+        for (int op = 0; op < 2; op++) {
+            const LatencySummary& l = *latencies[op];
+            file << result.engine << ","
+                 << result.workload << ","
+                 << result.num_elements << ","
+                 << operations[op] << ","
+                 << l.operations << ","
+                 << l.mean_ns << ","
+                 << l.p50_ns << ","
+                 << l.p99_ns << ","
+                 << l.p999_ns << ","
+                 << l.max_ns << "\n";
+        }
+    }
+
+    file.close();
+    std::cout << "✅ Exported latency percentiles to: " << filename << std::endl;
+}
+
+static std::string jsonLatency(const LatencySummary& l) {
+    std::ostringstream out;
+    out << "{\"operations\": " << l.operations
+        << ", \"mean_ns\": " << l.mean_ns
+        << ", \"p50_ns\": " << l.p50_ns
+        << ", \"p99_ns\": " << l.p99_ns
+        << ", \"p999_ns\": " << l.p999_ns
+        << ", \"max_ns\": " << l.max_ns << "}";
+    return out.str();
+}
+
+// Events that were not counted are null
+static std::string jsonCounters(const PhaseCounters& counters) {
+    std::ostringstream out;
+    out << "{";
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        out << (e == 0 ? "" : ", ") << "\"" << perfEventName(static_cast<PerfEvent>(e)) << "_per_op\": ";
+        if (counters.per_op[e] < 0) {
+            out << "null";
+        } else {
+            out << counters.per_op[e];
+        }
+    }
+    out << "}";
+    return out.str();
+}
+
+static std::string jsonAccesses(const AccessCounts& a) {
+    if (a.nodes_visited < 0) {
+        return "null";
+    }
+    std::ostringstream out;
+    out << "{\"nodes_visited_per_op\": " << a.nodes_visited
+        << ", \"comparisons_per_op\": " << a.key_comparisons
+        << ", \"splits_per_op\": " << a.node_splits
+        << ", \"bytes_moved_per_op\": " << a.bytes_moved << "}";
+    return out.str();
+}
+
+static std::string jsonString(const std::string& value) {
+    std::ostringstream out;
+    out << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+void BenchmarkHarness::exportJSON(const std::vector<CaseResult>& results, const HarnessConfig& config,
+                                  const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return;
+    }
+
+    file << "{\n"
+         << "  \"config\": {\"warmup_runs\": " << config.warmup_runs
+         << ", \"repetitions\": " << config.repetitions
+         << ", \"min_repetitions\": " << config.min_repetitions
+         << ", \"case_budget_us\": " << config.case_budget_us
+         << ", \"perf_counters\": " << (config.perf_counters ? "true" : "false")
+         << ", \"instrumented\": " << (TREE_INSTRUMENTED ? "true" : "false") << "},\n"
+         << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const CaseResult& result = results[i];
+        file << (i == 0 ? "\n" : ",\n")
+             << "    {\"engine\": " << jsonString(result.engine)
+             << ", \"workload\": " << jsonString(result.workload)
+             << ", \"num_elements\": " << result.num_elements
+             << ", \"tree_height\": " << result.tree_height
+             << ", \"repetitions\": " << result.repetitions
+             << ", \"phases\": {";
+        for (int p = 0; p < BENCHMARK_PHASES; p++) {
+            const TimingSummary& s = result.phases[p];
+            file << (p == 0 ? "\n" : ",\n")
+                 << "      " << jsonString(benchmarkPhaseName(static_cast<BenchmarkPhase>(p)))
+                 << ": {\"mean_us\": " << s.mean_us
+                 << ", \"median_us\": " << s.median_us
+                 << ", \"stddev_us\": " << s.stddev_us
+                 << ", \"min_us\": " << s.min_us
+                 << ", \"max_us\": " << s.max_us
+                 << ", \"ci95_low_us\": " << s.ci95_low_us
+                 << ", \"ci95_high_us\": " << s.ci95_high_us
+                 << ", \"counters\": " << jsonCounters(result.counters[p])
+                 << ", \"accesses\": " << jsonAccesses(result.accesses[p]) << "}";
+        }
+        file << "\n    }, \"latency\": {\"Insert\": " << jsonLatency(result.insert_latency)
+             << ", \"Search\": " << jsonLatency(result.search_latency) << "}}";
+    }
+    file << "\n  ]\n}\n";
+
+    file.close();
+    std::cout << "✅ Exported harness results to: " << filename << std::endl;
+}
@@ -1,10 +1,22 @@
 #include "bst.h"
+#include "instrumentation.h"
 #include <string>
+#include <new>
+#include <type_traits>
 
-// Destructor - delete all nodes
+template <typename T>
+BST<T>::BST(NodeAllocatorKind allocatorKind)
+    : root(nullptr),
+      allocator(makeNodeAllocator(allocatorKind, sizeof(BSTNode<T>), alignof(BSTNode<T>))) {}
+
+// Destructor - delete all nodes. An arena or slab frees its blocks when
+// the allocator goes away, so the per-node walk is only needed for heap
+// nodes or keys with a destructor to run.
 template <typename T>
 BST<T>::~BST() {
-    deleteTree(root);
+    if (!allocator->releasesInBulk() || !std::is_trivially_destructible<T>::value) {
+        deleteTree(root);
+    }
 }
 
 template <typename T>
@@ -12,7 +24,19 @@ void BST<T>::deleteTree(BSTNode<T>* node) {
     if (node == nullptr) return;
     deleteTree(node->left);
     deleteTree(node->right);
-    delete node;
+    destroyNode(node);
+}
+
+template <typename T>
+BSTNode<T>* BST<T>::createNode(T key) {
+    void* memory = allocator->allocate(sizeof(BSTNode<T>), alignof(BSTNode<T>));
+    return new (memory) BSTNode<T>(key);
+}
+
+template <typename T>
+void BST<T>::destroyNode(BSTNode<T>* node) {
+    node->~BSTNode<T>();
+    allocator->deallocate(node, sizeof(BSTNode<T>));
 }
 
 // Insert a key into the BST
@@ -25,20 +49,54 @@ template <typename T>
 BSTNode<T>* BST<T>::insertHelper(BSTNode<T>* node, T key) {
     // Base case: empty tree or reached a leaf position
     if (node == nullptr) {
-        return new BSTNode<T>(key);
+        return createNode(key);
     }
+    TREE_COUNT_NODE_VISIT();
     
     // Recursive case: go left or right
     if (key < node->key) {
+        TREE_COUNT_COMPARISONS(1);
         node->left = insertHelper(node->left, key);
     } else if (key > node->key) {
+        TREE_COUNT_COMPARISONS(2);
         node->right = insertHelper(node->right, key);
+    } else {
+        TREE_COUNT_COMPARISONS(2);
     }
     // If key == node->key, don't insert duplicates
     
     return node;
 }
 
+// Remove a key. Iterative, since sequential input makes the tree a list.
+// A node with two children takes its in-order successor's key, and the
+// successor (which has no left child) is unlinked instead.
+template <typename T>
+bool BST<T>::remove(T key) {
+    BSTNode<T>** link = &root;
+    while (*link != nullptr && (*link)->key != key) {
+        link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+    }
+    BSTNode<T>* node = *link;
+    if (node == nullptr) {
+        return false;
+    }
+
+    if (node->left != nullptr && node->right != nullptr) {
+        BSTNode<T>** successor = &node->right;
+        while ((*successor)->left != nullptr) {
+            successor = &(*successor)->left;
+        }
+        node->key = (*successor)->key;
+        link = successor;
+        node = *successor;
+    }
+
+    *link = node->left != nullptr ? node->left : node->right;
+    destroyNode(node);
+    return true;
+}
+
 // Search for a key
 template <typename T>
 bool BST<T>::search(T key) {
@@ -48,11 +106,17 @@ bool BST<T>::search(T key) {
 template <typename T>
 BSTNode<T>* BST<T>::searchHelper(BSTNode<T>* node, T key) {
     // Base case: empty or found
-    if (node == nullptr || node->key == key) {
+    if (node == nullptr) {
+        return node;
+    }
+    TREE_COUNT_NODE_VISIT();
+    TREE_COUNT_COMPARISONS(1);
+    if (node->key == key) {
         return node;
     }
     
     // Recursive case
+    TREE_COUNT_COMPARISONS(1);
     if (key < node->key) {
         return searchHelper(node->left, key);
     } else {
@@ -60,6 +124,41 @@ BSTNode<T>* BST<T>::searchHelper(BSTNode<T>* node, T key) {
     }
 }
 
+// Iterator positioned at the smallest key
+template <typename T>
+BSTIterator<T> BST<T>::begin() {
+    iterator it;
+    it.pushLeftSpine(root);
+    return it;
+}
+
+// Iterator positioned at the first key >= key. Only nodes we turn left at
+// are pushed, since those are the ones still to be yielded.
+template <typename T>
+BSTIterator<T> BST<T>::lowerBound(T key) {
+    iterator it;
+    BSTNode<T>* node = root;
+    while (node != nullptr) {
+        if (node->key < key) {
+            node = node->right;
+        } else {
+            it.stack.push_back(node);
+            node = node->left;
+        }
+    }
+    return it;
+}
+
+// Range scan: one descent to the lower bound, then an in-order walk
+template <typename T>
+std::vector<T> BST<T>::rangeScan(T lo, T hi) {
+    std::vector<T> result;
+    for (iterator it = lowerBound(lo); it != end() && !(hi < *it); ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
 // In-order traversal (prints in sorted order)
 template <typename T>
 void BST<T>::traverse() {
@@ -106,3 +205,4 @@ void BST<T>::printTreeHelper(BSTNode<T>* node, int level) {
 // Template instantiation
 template class BST<int>;
 template class BSTNode<int>;
+template class BSTIterator<int>;
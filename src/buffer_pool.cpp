@@ -0,0 +1,328 @@
+#include "buffer_pool.h"
+#include <cstring>
+#include <stdexcept>
+
+
+
+std::string evictionPolicyName(EvictionPolicy policy) {
+    switch (policy) {
+        case EvictionPolicy::LRU:   return "LRU";
+        case EvictionPolicy::CLOCK: return "CLOCK";
+        case EvictionPolicy::TWO_Q: return "2Q";
+    }
+    return "Unknown";
+}
+
+
+// === LRU: list ordered by recency, evict from the back ===
+class LRUPolicy : public ReplacementPolicy {
+private:
+    std::list<size_t> order;  // front = most recently used
+    std::vector<std::list<size_t>::iterator> position;
+    std::vector<bool> tracked;
+
+public:
+    explicit LRUPolicy(size_t capacity) : position(capacity), tracked(capacity, false) {}
+
+    void recordAccess(size_t frame, PageId, bool) override {
+        if (tracked[frame]) {
+            order.erase(position[frame]);
+        }
+        order.push_front(frame);
+        position[frame] = order.begin();
+        tracked[frame] = true;
+    }
+
+    bool evict(const std::vector<BufferFrame>& frames, size_t& victim, bool cleanOnly) override {
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            if (evictable(frames[*it], cleanOnly)) {
+                victim = *it;
+                order.erase(position[victim]);
+                tracked[victim] = false;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+
+// === CLOCK: reference bit per frame, hand sweeps giving a second chance ===
+class ClockPolicy : public ReplacementPolicy {
+private:
+    std::vector<bool> ref_bit;
+    size_t hand;
+
+public:
+    explicit ClockPolicy(size_t capacity) : ref_bit(capacity, false), hand(0) {}
+
+    void recordAccess(size_t frame, PageId, bool) override {
+        ref_bit[frame] = true;
+    }
+
+    bool evict(const std::vector<BufferFrame>& frames, size_t& victim, bool cleanOnly) override {
+        size_t n = frames.size();
+        // Two full sweeps: the first may only clear reference bits
+        for (size_t step = 0; step < 2 * n; step++) {
+            size_t frame = hand;
+            hand = (hand + 1) % n;
+            if (!frames[frame].valid || !evictable(frames[frame], cleanOnly)) {
+                continue;
+            }
+            if (ref_bit[frame]) {
+                ref_bit[frame] = false;
+            } else {
+                victim = frame;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+
+// === 2Q: new pages enter a FIFO (A1in); pages re-referenced after leaving
+// A1in (remembered in the ghost queue A1out) are promoted to an LRU (Am).
+// One-off scans therefore cannot flush the hot set out of Am. ===
+class TwoQueuePolicy : public ReplacementPolicy {
+private:
+    enum Queue { NONE, A1IN, AM };
+
+    std::list<size_t> a1in;   // front = newest
+    std::list<size_t> am;     // front = most recently used
+    std::list<PageId> a1out;  // ghost entries, front = newest
+    std::unordered_map<PageId, std::list<PageId>::iterator> ghost_index;
+
+    std::vector<Queue> queue_of;
+    std::vector<std::list<size_t>::iterator> position;
+    size_t kin;    // Target size of A1in
+    size_t kout;   // Max ghost entries
+
+    void remember(PageId page) {
+        a1out.push_front(page);
+        ghost_index[page] = a1out.begin();
+        if (a1out.size() > kout) {
+            ghost_index.erase(a1out.back());
+            a1out.pop_back();
+        }
+    }
+
+    bool evictFrom(std::list<size_t>& queue, const std::vector<BufferFrame>& frames, size_t& victim,
+                   bool cleanOnly) {
+        for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+            if (evictable(frames[*it], cleanOnly)) {
+                victim = *it;
+                queue.erase(position[victim]);
+                queue_of[victim] = NONE;
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit TwoQueuePolicy(size_t capacity)
+        : queue_of(capacity, NONE), position(capacity),
+          kin(capacity / 4 > 0 ? capacity / 4 : 1),
+          kout(capacity / 2 > 0 ? capacity / 2 : 1) {}
+
+    void recordAccess(size_t frame, PageId page, bool loaded) override {
+        if (!loaded) {
+            // Hit: only Am is reordered; A1in stays FIFO
+            if (queue_of[frame] == AM) {
+                am.erase(position[frame]);
+                am.push_front(frame);
+                position[frame] = am.begin();
+            }
+            return;
+        }
+
+        auto ghost = ghost_index.find(page);
+        if (ghost != ghost_index.end()) {
+            a1out.erase(ghost->second);
+            ghost_index.erase(ghost);
+            am.push_front(frame);
+            position[frame] = am.begin();
+            queue_of[frame] = AM;
+        } else {
+            a1in.push_front(frame);
+            position[frame] = a1in.begin();
+            queue_of[frame] = A1IN;
+        }
+    }
+
+    bool evict(const std::vector<BufferFrame>& frames, size_t& victim, bool cleanOnly) override {
+        if (a1in.size() > kin || am.empty()) {
+            if (evictFrom(a1in, frames, victim, cleanOnly)) {
+                remember(frames[victim].page_id);
+                return true;
+            }
+            return evictFrom(am, frames, victim, cleanOnly);
+        }
+        if (evictFrom(am, frames, victim, cleanOnly)) {
+            return true;
+        }
+        if (evictFrom(a1in, frames, victim, cleanOnly)) {
+            remember(frames[victim].page_id);
+            return true;
+        }
+        return false;
+    }
+};
+
+
+BufferPool::BufferPool(PageFile& pageFile, size_t capacityPages, EvictionPolicy evictionPolicy)
+    : file(pageFile), capacity(capacityPages), policy(evictionPolicy),
+      memory(capacityPages * pageFile.getPageSize() + PageFile::IO_ALIGNMENT), frames(capacityPages),
+      no_steal(false), dirty_pages(0), hits(0), misses(0), evictions(0), write_backs(0) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(memory.data());
+    frame_base = memory.data() + (PageFile::IO_ALIGNMENT - address % PageFile::IO_ALIGNMENT) % PageFile::IO_ALIGNMENT;
+
+    if (capacity == 0) {
+        throw std::runtime_error("Buffer pool needs at least one frame");
+    }
+
+    for (size_t i = 0; i < capacity; i++) {
+        frames[i].page_id = INVALID_PAGE_ID;
+        frames[i].pin_count = 0;
+        frames[i].dirty = false;
+        frames[i].valid = false;
+        free_frames.push_back(capacity - 1 - i);
+    }
+
+    switch (policy) {
+        case EvictionPolicy::LRU:
+            replacer.reset(new LRUPolicy(capacity));
+            break;
+        case EvictionPolicy::CLOCK:
+            replacer.reset(new ClockPolicy(capacity));
+            break;
+        case EvictionPolicy::TWO_Q:
+            replacer.reset(new TwoQueuePolicy(capacity));
+            break;
+    }
+}
+
+BufferPool::~BufferPool() {
+    // Destructors must not throw; callers that care about durability
+    // call flushAll() themselves and see the error there. A no-steal
+    // pool's owner decides when pages go out, so it is left alone.
+    if (no_steal) {
+        return;
+    }
+    try {
+        flushAll();
+    } catch (const std::exception&) {
+    }
+}
+
+void BufferPool::writeBack(size_t frame) {
+    file.writePage(frames[frame].page_id, frameData(frame));
+    frames[frame].dirty = false;
+    dirty_pages--;
+    write_backs++;
+}
+
+// Returns an empty frame, evicting (and writing back) a victim if needed
+size_t BufferPool::acquireFrame() {
+    if (!free_frames.empty()) {
+        size_t frame = free_frames.back();
+        free_frames.pop_back();
+        return frame;
+    }
+
+    size_t victim;
+    if (!replacer->evict(frames, victim, no_steal)) {
+        throw std::runtime_error("Buffer pool exhausted: all " + std::to_string(capacity) +
+                                 (no_steal ? " frames are pinned or dirty (no-steal)"
+                                           : " frames are pinned"));
+    }
+
+    if (frames[victim].dirty) {
+        writeBack(victim);
+    }
+    page_table.erase(frames[victim].page_id);
+    frames[victim].valid = false;
+    evictions++;
+    return victim;
+}
+
+char* BufferPool::fetchPage(PageId id) {
+    auto it = page_table.find(id);
+    if (it != page_table.end()) {
+        size_t frame = it->second;
+        frames[frame].pin_count++;
+        replacer->recordAccess(frame, id, false);
+        hits++;
+        return frameData(frame);
+    }
+
+    size_t frame = acquireFrame();
+    try {
+        file.readPage(id, frameData(frame));
+    } catch (...) {
+        // The frame is off the free list and out of the replacer; hand it
+        // back, or every failed read would shrink the pool by one
+        free_frames.push_back(frame);
+        throw;
+    }
+    frames[frame].page_id = id;
+    frames[frame].pin_count = 1;
+    frames[frame].dirty = false;
+    frames[frame].valid = true;
+    page_table[id] = frame;
+    replacer->recordAccess(frame, id, true);
+    misses++;
+    return frameData(frame);
+}
+
+char* BufferPool::newPage(PageId& id) {
+    size_t frame = acquireFrame();
+    try {
+        id = file.allocatePage();
+    } catch (...) {
+        free_frames.push_back(frame);
+        throw;
+    }
+    std::memset(frameData(frame), 0, file.getPageSize());
+    frames[frame].page_id = id;
+    frames[frame].pin_count = 1;
+    frames[frame].dirty = true;
+    frames[frame].valid = true;
+    dirty_pages++;
+    page_table[id] = frame;
+    replacer->recordAccess(frame, id, true);
+    return frameData(frame);
+}
+
+void BufferPool::unpinPage(PageId id, bool dirty) {
+    auto it = page_table.find(id);
+    if (it == page_table.end()) {
+        throw std::runtime_error("Unpin of page " + std::to_string(id) + " that is not cached");
+    }
+    BufferFrame& frame = frames[it->second];
+    if (frame.pin_count <= 0) {
+        throw std::runtime_error("Unpin of page " + std::to_string(id) + " that is not pinned");
+    }
+    frame.pin_count--;
+    if (dirty && !frame.dirty) {
+        frame.dirty = true;
+        dirty_pages++;
+    }
+}
+
+void BufferPool::flushAll() {
+    for (size_t i = 0; i < capacity; i++) {
+        if (frames[i].valid && frames[i].dirty) {
+            writeBack(i);
+        }
+    }
+}
+
+void BufferPool::forEachDirtyPage(const std::function<void(PageId, const char*)>& visit) {
+    for (size_t i = 0; i < capacity; i++) {
+        if (frames[i].valid && frames[i].dirty) {
+            visit(frames[i].page_id, frameData(i));
+        }
+    }
+}
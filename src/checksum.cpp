@@ -0,0 +1,31 @@
+#include "checksum.h"
+
+
+
+// Byte-at-a-time table, built once on first use
+static const uint32_t* crcTable() {
+    static uint32_t table[256];
+    static bool ready = [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)ready;
+    return table;
+}
+
+uint32_t crc32(const void* data, size_t length, uint32_t crc) {
+    const uint32_t* table = crcTable();
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
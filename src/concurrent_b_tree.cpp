@@ -0,0 +1,290 @@
+#include "concurrent_b_tree.h"
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+
+
+// === OptimisticLatch ===
+
+uint64_t OptimisticLatch::readLock(bool& restart) const {
+    uint64_t v = version.load(std::memory_order_acquire);
+    if (v & LOCKED) {
+        std::this_thread::yield();  // Let the writer finish before retrying
+        restart = true;
+    }
+    return v;
+}
+
+bool OptimisticLatch::validate(uint64_t v) const {
+    // Order the optimistic data reads before the version re-check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version.load(std::memory_order_relaxed) == v;
+}
+
+bool OptimisticLatch::upgrade(uint64_t v) {
+    return version.compare_exchange_strong(v, v + LOCKED, std::memory_order_acquire);
+}
+
+void OptimisticLatch::writeUnlock() {
+    version.fetch_add(LOCKED, std::memory_order_release);
+}
+
+
+// === ConcurrentBTree ===
+
+// The root is never null, so readers need no special case for an empty tree
+template <typename T, int Degree>
+ConcurrentBTree<T, Degree>::ConcurrentBTree() : root(nullptr), restarts(0) {
+    root.store(allocateNode(true));
+}
+
+template <typename T, int Degree>
+ConcurrentBTree<T, Degree>::~ConcurrentBTree() {
+    destroy(root.load());
+}
+
+// Nodes are over-aligned, which plain new only guarantees from C++17 on
+template <typename T, int Degree>
+typename ConcurrentBTree<T, Degree>::Node* ConcurrentBTree<T, Degree>::allocateNode(bool leaf) {
+    void* memory = nullptr;
+    if (posix_memalign(&memory, alignof(Node), sizeof(Node)) != 0) {
+        throw std::bad_alloc();
+    }
+    return new (memory) Node(leaf);
+}
+
+template <typename T, int Degree>
+void ConcurrentBTree<T, Degree>::destroy(Node* node) {
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) {
+            destroy(node->child(i));
+        }
+    }
+    node->~Node();
+    free(node);
+}
+
+// Same as FixedBTree::splitChild. Caller holds both latches; the new
+// node is unreachable until the parent latch is released.
+template <typename T, int Degree>
+void ConcurrentBTree<T, Degree>::splitChild(Node* parent, int index, Node* child) {
+    Node* newNode = allocateNode(child->is_leaf);
+
+    for (int j = 0; j < Degree - 1; j++) {
+        newNode->keys[j] = child->keys[j + Degree];
+        child->keys[j + Degree] = std::numeric_limits<T>::max();
+    }
+    if (!child->is_leaf) {
+        for (int j = 0; j < Degree; j++) {
+            newNode->children[j] = child->children[j + Degree];
+        }
+    }
+    newNode->num_keys = Degree - 1;
+
+    T middleKey = child->keys[Degree - 1];
+    child->keys[Degree - 1] = std::numeric_limits<T>::max();
+    child->num_keys = Degree - 1;
+
+    for (int j = parent->num_keys; j > index; j--) {
+        parent->children[j + 1] = parent->children[j];
+        parent->keys[j] = parent->keys[j - 1];
+    }
+    parent->children[index + 1] = newNode;
+    parent->keys[index] = middleKey;
+    parent->num_keys++;
+}
+
+
+// One optimistic descent. Returns true once the key is in; false means
+// try again, with restart set when the attempt lost a race (a split
+// also returns false, but without restart: it is progress, not a conflict).
+template <typename T, int Degree>
+bool ConcurrentBTree<T, Degree>::tryInsert(T key, bool& restart) {
+    Node* node = root.load(std::memory_order_acquire);
+    uint64_t v = node->latch.readLock(restart);
+    if (restart) return false;
+
+    // The root pointer only changes while the old root is latched, so if
+    // it is still the root now, validating v later covers a root split too
+    if (node != root.load(std::memory_order_acquire)) {
+        restart = true;
+        return false;
+    }
+
+    // Full root: grow the tree by one level
+    if (node->isFull()) {
+        if (!node->latch.upgrade(v)) {
+            restart = true;
+            return false;
+        }
+        Node* newRoot = allocateNode(false);
+        newRoot->children[0] = node;
+        splitChild(newRoot, 0, node);
+        root.store(newRoot, std::memory_order_release);
+        node->latch.writeUnlock();
+        return false;
+    }
+
+    while (!node->is_leaf) {
+        int i = node->upperBound(key);
+        Node* child = node->child(i);
+        if (!node->latch.validate(v)) {
+            restart = true;
+            return false;
+        }
+
+        uint64_t childVersion = child->latch.readLock(restart);
+        if (restart) return false;
+
+        // Proactive split: the only place a writer latches an internal node
+        if (child->isFull()) {
+            if (!node->latch.upgrade(v)) {
+                restart = true;
+                return false;
+            }
+            if (!child->latch.upgrade(childVersion)) {
+                node->latch.writeUnlock();
+                restart = true;
+                return false;
+            }
+            splitChild(node, i, child);
+            child->latch.writeUnlock();
+            node->latch.writeUnlock();
+            return false;
+        }
+
+        // Parent unchanged since we picked child, so child is still the right one
+        if (!node->latch.validate(v)) {
+            restart = true;
+            return false;
+        }
+        node = child;
+        v = childVersion;
+    }
+
+    if (!node->latch.upgrade(v)) {
+        restart = true;
+        return false;
+    }
+    int pos = node->upperBound(key);
+    for (int j = node->num_keys; j > pos; j--) {
+        node->keys[j] = node->keys[j - 1];
+    }
+    node->keys[pos] = key;
+    node->num_keys++;
+    node->latch.writeUnlock();
+    return true;
+}
+
+template <typename T, int Degree>
+void ConcurrentBTree<T, Degree>::insert(T key) {
+    while (true) {
+        bool restart = false;
+        if (tryInsert(key, restart)) {
+            return;
+        }
+        if (restart) {
+            restarts.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+// Nothing read from a node is trusted until its version is re-validated:
+// the child pointer before we touch the child, and the parent again after
+// reading the child's version, so a split that moved our key away from
+// the child is noticed.
+template <typename T, int Degree>
+bool ConcurrentBTree<T, Degree>::trySearch(T key, bool& restart) const {
+    Node* node = root.load(std::memory_order_acquire);
+    uint64_t v = node->latch.readLock(restart);
+    if (restart) return false;
+
+    while (true) {
+        int i = node->lowerBound(key);
+        bool found = i < node->num_keys && node->keys[i] == key;
+        bool leaf = node->is_leaf;
+        Node* child = (found || leaf) ? nullptr : node->child(i);
+        if (!node->latch.validate(v)) {
+            restart = true;
+            return false;
+        }
+        if (found || leaf) {
+            return found;
+        }
+
+        uint64_t childVersion = child->latch.readLock(restart);
+        if (restart) return false;
+        if (!node->latch.validate(v)) {
+            restart = true;
+            return false;
+        }
+        node = child;
+        v = childVersion;
+    }
+}
+
+template <typename T, int Degree>
+bool ConcurrentBTree<T, Degree>::search(T key) const {
+    while (true) {
+        bool restart = false;
+        bool found = trySearch(key, restart);
+        if (!restart) {
+            return found;
+        }
+        restarts.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+// In-order walk with an explicit stack of (node, next index)
+template <typename T, int Degree>
+std::vector<T> ConcurrentBTree<T, Degree>::rangeScan(T lo, T hi) const {
+    std::vector<T> result;
+    std::vector<std::pair<Node*, int>> stack;
+
+    Node* node = root.load();
+    while (true) {
+        int i = node->lowerBound(lo);
+        stack.push_back(std::make_pair(node, i));
+        if (node->is_leaf) break;
+        node = node->child(i);
+    }
+
+    while (!stack.empty()) {
+        std::pair<Node*, int>& top = stack.back();
+        node = top.first;
+        if (top.second >= node->num_keys) {
+            stack.pop_back();
+            continue;
+        }
+        T key = node->keys[top.second++];
+        if (hi < key) {
+            break;
+        }
+        result.push_back(key);
+        if (!node->is_leaf) {
+            // Leftmost path of the subtree right of the key just emitted
+            for (Node* child = node->child(top.second); ; child = child->child(0)) {
+                stack.push_back(std::make_pair(child, 0));
+                if (child->is_leaf) break;
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T, int Degree>
+int ConcurrentBTree<T, Degree>::getHeight() const {
+    int height = 1;
+    for (Node* node = root.load(); !node->is_leaf; node = node->child(0)) {
+        height++;
+    }
+    return height;
+}
+
+
+template class ConcurrentBTree<int, 16>;
+template class ConcurrentBTree<int, 64>;
+template class ConcurrentBTree<int, 100>;
@@ -0,0 +1,202 @@
+#include "cow_b_tree.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+
+// === CowSnapshot ===
+
+template <typename T>
+bool CowSnapshot<T>::search(T key) const {
+    const CowNode<T>* node = state->root.get();
+    while (node != nullptr) {
+        auto it = std::lower_bound(node->keys.begin(), node->keys.end(), key);
+        if (it != node->keys.end() && !(key < *it)) {
+            return true;
+        }
+        if (node->is_leaf) {
+            return false;
+        }
+        node = node->children[it - node->keys.begin()].get();
+    }
+    return false;
+}
+
+// In-order walk with an explicit stack of (node, next index)
+template <typename T>
+std::vector<T> CowSnapshot<T>::rangeScan(T lo, T hi) const {
+    std::vector<T> result;
+    std::vector<std::pair<const CowNode<T>*, size_t>> stack;
+
+    for (const CowNode<T>* node = state->root.get(); node != nullptr; ) {
+        size_t i = std::lower_bound(node->keys.begin(), node->keys.end(), lo) - node->keys.begin();
+        stack.push_back(std::make_pair(node, i));
+        node = node->is_leaf ? nullptr : node->children[i].get();
+    }
+
+    while (!stack.empty()) {
+        std::pair<const CowNode<T>*, size_t>& top = stack.back();
+        const CowNode<T>* node = top.first;
+        if (top.second >= node->keys.size()) {
+            stack.pop_back();
+            continue;
+        }
+        T key = node->keys[top.second++];
+        if (hi < key) {
+            break;
+        }
+        result.push_back(key);
+        if (!node->is_leaf) {
+            // Leftmost path of the subtree right of the key just emitted
+            for (const CowNode<T>* child = node->children[top.second].get(); ;
+                 child = child->children[0].get()) {
+                stack.push_back(std::make_pair(child, 0));
+                if (child->is_leaf) break;
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+int CowSnapshot<T>::getHeight() const {
+    int height = 0;
+    for (const CowNode<T>* node = state->root.get(); node != nullptr;
+         node = node->is_leaf ? nullptr : node->children[0].get()) {
+        height++;
+    }
+    return height;
+}
+
+
+// === CowBTree ===
+
+template <typename T>
+CowBTree<T>::CowBTree(int degree)
+    : min_degree(degree), inserts(0), nodes_copied(0), bytes_copied(0), nodes_modified(0) {
+    if (degree < 2) {
+        throw std::runtime_error("CowBTree needs a minimum degree of at least 2");
+    }
+    std::shared_ptr<CowVersion<T>> empty = std::make_shared<CowVersion<T>>();
+    empty->num_keys = 0;
+    empty->version = 0;
+    current = empty;
+}
+
+template <typename T>
+CowSnapshot<T> CowBTree<T>::snapshot() const {
+    return CowSnapshot<T>(std::atomic_load(&current));
+}
+
+template <typename T>
+void CowBTree<T>::resetStats() {
+    std::lock_guard<std::mutex> lock(writer);
+    inserts = 0;
+    nodes_copied = 0;
+    bytes_copied = 0;
+    nodes_modified = 0;
+}
+
+// Private, mutable copy of a published node: the unit of write amplification
+template <typename T>
+typename CowBTree<T>::NodePtr CowBTree<T>::copyNode(const ConstNodePtr& node) {
+    NodePtr copy = std::make_shared<Node>(*node);
+    nodes_copied++;
+    bytes_copied += copy->keys.size() * sizeof(T) + copy->children.size() * sizeof(ConstNodePtr);
+    return copy;
+}
+
+// Split the full, still published child at parent.children[index] into two
+// new nodes. parent is a private copy; the old child is left untouched for
+// the readers that can still see it.
+template <typename T>
+void CowBTree<T>::splitChild(Node& parent, int index, NodePtr& left, NodePtr& right) {
+    const Node& child = *parent.children[index];
+
+    left = std::make_shared<Node>(child.is_leaf);
+    right = std::make_shared<Node>(child.is_leaf);
+    left->keys.assign(child.keys.begin(), child.keys.begin() + (min_degree - 1));
+    right->keys.assign(child.keys.begin() + min_degree, child.keys.end());
+    if (!child.is_leaf) {
+        left->children.assign(child.children.begin(), child.children.begin() + min_degree);
+        right->children.assign(child.children.begin() + min_degree, child.children.end());
+    }
+    T middleKey = child.keys[min_degree - 1];
+
+    parent.keys.insert(parent.keys.begin() + index, middleKey);
+    parent.children[index] = left;
+    parent.children.insert(parent.children.begin() + index + 1, right);
+
+    nodes_copied += 2;
+    bytes_copied += (left->keys.size() + right->keys.size()) * sizeof(T) +
+                    (left->children.size() + right->children.size()) * sizeof(ConstNodePtr);
+}
+
+// Copy the path, then publish. dirty tracks whether the node we are at has
+// changed contents (not just a repointed child), which is what an in-place
+// tree would have had to write.
+template <typename T>
+void CowBTree<T>::insert(T key) {
+    std::lock_guard<std::mutex> lock(writer);
+    std::shared_ptr<const CowVersion<T>> old = std::atomic_load(&current);
+
+    NodePtr root;
+    NodePtr node;
+    bool dirty;
+
+    if (!old->root) {
+        root = std::make_shared<Node>(true);
+        nodes_copied++;
+        node = root;
+        dirty = true;
+    } else if (old->root->keys.size() == maxKeys()) {
+        // Full root: grow the tree by one level
+        root = std::make_shared<Node>(false);
+        root->children.push_back(old->root);
+        NodePtr left, right;
+        splitChild(*root, 0, left, right);
+        nodes_copied++;
+        nodes_modified += 3;   // New root plus the two halves
+        node = (root->keys[0] < key) ? right : left;
+        dirty = true;
+    } else {
+        root = copyNode(old->root);
+        node = root;
+        dirty = false;
+    }
+
+    while (!node->is_leaf) {
+        // Position after the last key <= key, as BtreeNode::insertNonFull
+        int i = std::upper_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+        NodePtr next;
+
+        if (node->children[i]->keys.size() == maxKeys()) {
+            NodePtr left, right;
+            splitChild(*node, i, left, right);
+            nodes_modified += dirty ? 2 : 3;
+            next = (node->keys[i] < key) ? right : left;
+            dirty = true;
+        } else {
+            next = copyNode(node->children[i]);
+            node->children[i] = next;
+            dirty = false;
+        }
+        node = next;
+    }
+
+    node->keys.insert(std::upper_bound(node->keys.begin(), node->keys.end(), key), key);
+    if (!dirty) {
+        nodes_modified++;
+    }
+    inserts++;
+
+    std::shared_ptr<CowVersion<T>> next = std::make_shared<CowVersion<T>>();
+    next->root = root;
+    next->num_keys = old->num_keys + 1;
+    next->version = old->version + 1;
+    std::atomic_store(&current, std::shared_ptr<const CowVersion<T>>(next));
+}
+
+
+template class CowSnapshot<int>;
+template class CowBTree<int>;
@@ -0,0 +1,509 @@
+#include "disk_b_tree.h"
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+
+
+static size_t poolCapacity(const DiskBTreeConfig& config) {
+    return config.pool_pages < DiskBTreeConfig::MIN_POOL_PAGES ? DiskBTreeConfig::MIN_POOL_PAGES
+                                                                : config.pool_pages;
+}
+
+template <typename T>
+DiskBTree<T>::DiskBTree(const std::string& path, const DiskBTreeConfig& config, bool create)
+    : file(path, config.page_size, create, config.direct_io),
+      pool(file, poolCapacity(config), config.policy),
+      root(INVALID_PAGE_ID), min_degree(config.min_degree), num_keys(0), height(0),
+      checkpoint_records(config.checkpoint_records), checkpoints(0) {
+    if (!config.wal_path.empty()) {
+        wal.reset(new WriteAheadLog(config.wal_path, config.group_commit, create));
+        pool.setNoSteal(true);
+    }
+
+    if (create) {
+        int max_degree = maxDegreeForPage(config.page_size);
+        if (min_degree <= 0 || min_degree > max_degree) {
+            min_degree = max_degree;
+        }
+        if (min_degree < 2) {
+            throw std::runtime_error("Page size too small for a B-tree node");
+        }
+        max_keys = 2 * min_degree - 1;
+
+        // Reserve page 0 for metadata
+        PageId metaId;
+        pool.newPage(metaId);
+        pool.unpinPage(metaId, true);
+        writeMeta();
+
+        // A durable tree must be readable from disk before its first insert is logged
+        if (wal) {
+            checkpoint();
+        }
+    } else if (wal) {
+        recover();
+    } else {
+        readMeta();
+        height = getHeight();
+    }
+}
+
+template <typename T>
+DiskBTree<T>::~DiskBTree() {
+    // Destructors must not throw; a failed final metadata write only
+    // loses the key count, the pool still writes back the nodes. A durable
+    // tree shuts down with a checkpoint; if that fails, the log still
+    // holds everything and the next open recovers it.
+    try {
+        if (wal) {
+            checkpoint();
+        } else {
+            writeMeta();
+        }
+    } catch (const std::exception&) {
+    }
+}
+
+template <typename T>
+void DiskBTree<T>::writeMeta() {
+    DiskTreeMeta meta;
+    meta.magic = DISK_BTREE_MAGIC;
+    meta.version = DISK_BTREE_VERSION;
+    meta.page_size = static_cast<uint32_t>(file.getPageSize());
+    meta.key_size = sizeof(T);
+    meta.min_degree = static_cast<uint32_t>(min_degree);
+    meta.root = root;
+    meta.num_keys = num_keys;
+
+    char* page = pool.fetchPage(0);
+    std::memcpy(page, &meta, sizeof(meta));
+    pool.unpinPage(0, true);
+}
+
+template <typename T>
+void DiskBTree<T>::readMeta() {
+    if (file.getNumPages() == 0) {
+        throw std::runtime_error("Not a B-tree file (empty): " + file.getPath());
+    }
+
+    DiskTreeMeta meta;
+    char* page = pool.fetchPage(0);
+    std::memcpy(&meta, page, sizeof(meta));
+    pool.unpinPage(0, false);
+
+    if (meta.magic != DISK_BTREE_MAGIC || meta.version != DISK_BTREE_VERSION) {
+        throw std::runtime_error("Not a B-tree file (bad magic/version): " + file.getPath());
+    }
+    if (meta.page_size != file.getPageSize() || meta.key_size != sizeof(T)) {
+        throw std::runtime_error("B-tree file was written with a different page or key size: " +
+                                 file.getPath());
+    }
+
+    min_degree = static_cast<int>(meta.min_degree);
+    max_keys = 2 * min_degree - 1;
+    root = meta.root;
+    num_keys = meta.num_keys;
+}
+
+template <typename T>
+void DiskBTree<T>::flush() {
+    if (wal) {
+        checkpoint();
+        return;
+    }
+    writeMeta();
+    pool.flushAll();
+    file.sync();
+}
+
+
+// === Write-ahead logging ===
+
+template <typename T>
+void DiskBTree<T>::commit() {
+    if (wal) {
+        wal->commit();
+    }
+}
+
+// The page images and the CHECKPOINT record are durable before any page
+// is overwritten, so a crash during the write-back leaves a complete copy
+// of every page it was writing in the log.
+template <typename T>
+void DiskBTree<T>::checkpoint() {
+    if (!wal) {
+        flush();
+        return;
+    }
+
+    writeMeta();
+    std::vector<char> image(sizeof(PageId) + file.getPageSize());
+    pool.forEachDirtyPage([&](PageId id, const char* data) {
+        std::memcpy(image.data(), &id, sizeof(PageId));
+        std::memcpy(image.data() + sizeof(PageId), data, file.getPageSize());
+        wal->append(WalRecordType::PAGE_IMAGE, image.data(), static_cast<uint32_t>(image.size()));
+    });
+    wal->append(WalRecordType::CHECKPOINT, nullptr, 0);
+    wal->commit();
+
+    pool.flushAll();
+    file.sync();
+    wal->reset();
+    checkpoints++;
+}
+
+// Checkpoint before the pool can run out of clean frames. An insert
+// dirties at most two pages per level, a new root and the meta page, and
+// needs a few clean frames to pin while it descends.
+template <typename T>
+bool DiskBTree<T>::checkpointDue() const {
+    if (checkpoint_records > 0 && wal->getRecordsSinceCheckpoint() >= checkpoint_records) {
+        return true;
+    }
+    size_t worstCase = 2 * static_cast<size_t>(height + 1) + 1 + DiskBTreeConfig::MIN_POOL_PAGES;
+    return pool.getDirtyPages() + worstCase > pool.getCapacity();
+}
+
+// Page images of the last complete checkpoint go straight to the file:
+// that checkpoint may have crashed part-way through its write-back.
+// Images without a CHECKPOINT record behind them never reached the file
+// and are ignored. Inserts logged after the checkpoint are then applied
+// again. They were logged under the same dirty-page budget, so they fit
+// in the pool without an intermediate checkpoint (unless the tree is
+// reopened with a smaller pool, which then fails with nothing written).
+template <typename T>
+void DiskBTree<T>::recover() {
+    std::vector<std::pair<PageId, std::vector<char>>> images;
+    std::vector<T> keys;
+    size_t pageSize = file.getPageSize();
+
+    wal->replay([&](const WalRecordHeader& record, const char* payload) {
+        switch (static_cast<WalRecordType>(record.type)) {
+            case WalRecordType::INSERT: {
+                if (record.length != sizeof(T)) {
+                    throw std::runtime_error("Log insert record has the wrong key size: " + wal->getPath());
+                }
+                T key;
+                std::memcpy(&key, payload, sizeof(T));
+                keys.push_back(key);
+                break;
+            }
+            case WalRecordType::PAGE_IMAGE: {
+                if (record.length != sizeof(PageId) + pageSize) {
+                    throw std::runtime_error("Log page image has the wrong page size: " + wal->getPath());
+                }
+                PageId id;
+                std::memcpy(&id, payload, sizeof(PageId));
+                images.push_back(std::make_pair(id, std::vector<char>(payload + sizeof(PageId),
+                                                                      payload + record.length)));
+                break;
+            }
+            case WalRecordType::CHECKPOINT:
+                for (size_t i = 0; i < images.size(); i++) {
+                    file.writePage(images[i].first, images[i].second.data());
+                }
+                file.sync();
+                images.clear();
+                keys.clear();   // Already in the images
+                break;
+            default:
+                throw std::runtime_error("Unknown log record type in " + wal->getPath());
+        }
+    });
+
+    readMeta();
+    height = getHeight();
+    for (size_t i = 0; i < keys.size(); i++) {
+        insertKey(keys[i]);
+    }
+    if (wal->getRecordsSinceCheckpoint() > 0) {
+        checkpoint();
+    }
+}
+
+
+// Search: one page fetch per level
+template <typename T>
+bool DiskBTree<T>::search(T key) {
+    PageId id = root;
+
+    while (id != INVALID_PAGE_ID) {
+        DiskNodeView<T> node = view(pool.fetchPage(id));
+
+        // Find the first key greater than or equal to the search key
+        int n = node.numKeys();
+        int i = 0;
+        while (i < n && key > node.key(i)) {
+            i++;
+        }
+
+        bool found = (i < n && node.key(i) == key);
+        PageId next = (found || node.isLeaf()) ? INVALID_PAGE_ID : node.child(i);
+        pool.unpinPage(id, false);
+
+        if (found) {
+            return true;
+        }
+        id = next;
+    }
+    return false;
+}
+
+
+// === Asynchronous reads ===
+
+// The root is read once up front, as a buffer pool would keep it cached;
+// below it each probe has at most one read in flight, tagged with its
+// index, and a probe that needs another level goes to the back of the
+// queue.
+template <typename T>
+size_t DiskBTree<T>::searchBatch(const T* probes, size_t count, std::vector<bool>& found,
+                                 AsyncPageReader& reader) {
+    found.assign(count, false);
+    if (root == INVALID_PAGE_ID || count == 0) {
+        return 0;
+    }
+
+    std::vector<char> rootPage(file.getPageSize());
+    file.readPage(root, rootPage.data());
+    size_t pagesRead = 1;
+
+    // Where a probe goes next from a node: done (found or at a leaf), or a child
+    auto route = [&](DiskNodeView<T> node, size_t probe, std::deque<std::pair<size_t, PageId>>& pending) {
+        T key = probes[probe];
+        int n = node.numKeys();
+        int i = 0;
+        while (i < n && node.key(i) < key) {
+            i++;
+        }
+        if (i < n && node.key(i) == key) {
+            found[probe] = true;
+        } else if (!node.isLeaf()) {
+            pending.push_back(std::make_pair(probe, node.child(i)));
+        }
+    };
+
+    std::deque<std::pair<size_t, PageId>> pending;
+    for (size_t probe = 0; probe < count; probe++) {
+        route(view(rootPage.data()), probe, pending);
+    }
+
+    std::vector<PageReadCompletion> completed;
+    while (!pending.empty() || reader.inFlight() > 0) {
+        while (!pending.empty() && !reader.full()) {
+            reader.read(pending.front().second, pending.front().first);
+            pending.pop_front();
+        }
+        completed.clear();
+        reader.wait(completed);
+        for (const PageReadCompletion& done : completed) {
+            route(view(done.data), static_cast<size_t>(done.tag), pending);
+            pagesRead++;
+        }
+    }
+    return pagesRead;
+}
+
+// Every subtree that overlaps [lo, hi] is queued as soon as its parent
+// arrives: child i holds the keys between key(i-1) and key(i), so it is
+// read unless the range ends before key(i-1) or starts after key(i).
+// Keys come back in page arrival order and are sorted at the end.
+template <typename T>
+std::vector<T> DiskBTree<T>::rangeScan(T lo, T hi, AsyncPageReader& reader) {
+    std::vector<T> result;
+    if (root == INVALID_PAGE_ID || hi < lo) {
+        return result;
+    }
+
+    std::vector<PageId> pending(1, root);
+    std::vector<PageReadCompletion> completed;
+    while (!pending.empty() || reader.inFlight() > 0) {
+        while (!pending.empty() && !reader.full()) {
+            reader.read(pending.back(), 0);
+            pending.pop_back();
+        }
+        completed.clear();
+        reader.wait(completed);
+
+        for (const PageReadCompletion& done : completed) {
+            DiskNodeView<T> node = view(done.data);
+            int n = node.numKeys();
+            for (int i = 0; i <= n; i++) {
+                bool afterLo = (i == n) || !(node.key(i) < lo);
+                bool beforeHi = (i == 0) || !(hi < node.key(i - 1));
+                if (!node.isLeaf() && afterLo && beforeHi) {
+                    pending.push_back(node.child(i));
+                }
+                if (i < n && afterLo && !(hi < node.key(i))) {
+                    result.push_back(node.key(i));
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+// Split the full child at children[index] of parent. Mirrors
+// BtreeNode::splitChild; parent and child stay pinned by the caller, the
+// new sibling comes back pinned and dirty.
+template <typename T>
+char* DiskBTree<T>::splitChild(char* parentPage, int index, char* childPage, PageId& siblingId) {
+    DiskNodeView<T> parent = view(parentPage);
+    DiskNodeView<T> child = view(childPage);
+
+    char* siblingPage = pool.newPage(siblingId);
+    DiskNodeView<T> sibling = view(siblingPage);
+    sibling.init(child.isLeaf());
+
+    // Copy the last (min_degree-1) keys and min_degree children to the sibling
+    for (int j = 0; j < min_degree - 1; j++) {
+        sibling.setKey(j, child.key(j + min_degree));
+    }
+    if (!child.isLeaf()) {
+        for (int j = 0; j < min_degree; j++) {
+            sibling.setChild(j, child.child(j + min_degree));
+        }
+    }
+    sibling.setNumKeys(min_degree - 1);
+
+    T middleKey = child.key(min_degree - 1);
+    child.setNumKeys(min_degree - 1);
+
+    // Make room in the parent for the middle key and the new child
+    parent.shiftChildrenRight(index + 1);
+    parent.setChild(index + 1, siblingId);
+    parent.shiftKeysRight(index);
+    parent.setKey(index, middleKey);
+    parent.setNumKeys(parent.numKeys() + 1);
+
+    return siblingPage;
+}
+
+// Descend from a pinned, non-full node to the leaf, splitting full
+// children on the way down. Takes over the caller's pin on the start page
+// and unpins every page it finishes with.
+template <typename T>
+void DiskBTree<T>::insertNonFull(PageId id, char* page, bool dirty, T key) {
+    while (true) {
+        DiskNodeView<T> node = view(page);
+
+        // Position after the last key <= key
+        int i = node.numKeys();
+        while (i > 0 && node.key(i - 1) > key) {
+            i--;
+        }
+
+        if (node.isLeaf()) {
+            node.shiftKeysRight(i);
+            node.setKey(i, key);
+            node.setNumKeys(node.numKeys() + 1);
+            pool.unpinPage(id, true);
+            return;
+        }
+
+        PageId childId = node.child(i);
+        char* childPage = pool.fetchPage(childId);
+        bool childDirty = false;
+
+        if (view(childPage).isFull()) {
+            PageId siblingId;
+            char* siblingPage = splitChild(page, i, childPage, siblingId);
+            dirty = true;
+            childDirty = true;
+
+            // After split, decide which of the two children to use
+            if (node.key(i) < key) {
+                pool.unpinPage(childId, true);
+                childId = siblingId;
+                childPage = siblingPage;
+            } else {
+                pool.unpinPage(siblingId, true);
+            }
+        }
+
+        pool.unpinPage(id, dirty);
+        id = childId;
+        page = childPage;
+        dirty = childDirty;
+    }
+}
+
+// Log first, then apply: the record is in the commit group before any
+// page changes
+template <typename T>
+void DiskBTree<T>::insert(T key) {
+    if (wal) {
+        if (checkpointDue()) {
+            checkpoint();
+        }
+        wal->append(WalRecordType::INSERT, &key, sizeof(T));
+    }
+    insertKey(key);
+}
+
+template <typename T>
+void DiskBTree<T>::insertKey(T key) {
+    // Case 1: Tree is empty
+    if (root == INVALID_PAGE_ID) {
+        DiskNodeView<T> node = view(pool.newPage(root));
+        node.init(true);
+        node.setKey(0, key);
+        node.setNumKeys(1);
+        pool.unpinPage(root, true);
+        num_keys = 1;
+        height = 1;
+        writeMeta();
+        return;
+    }
+
+    char* rootPage = pool.fetchPage(root);
+
+    // Case 2: Root is full - grow the tree by one level
+    if (view(rootPage).isFull()) {
+        PageId newRoot;
+        char* newRootPage = pool.newPage(newRoot);
+        DiskNodeView<T> node = view(newRootPage);
+        node.init(false);
+        node.setChild(0, root);
+
+        PageId siblingId;
+        splitChild(newRootPage, 0, rootPage, siblingId);
+        pool.unpinPage(siblingId, true);
+        pool.unpinPage(root, true);
+
+        root = newRoot;
+        height++;
+        writeMeta();
+        insertNonFull(root, newRootPage, true, key);
+    }
+    // Case 3: Root is not full
+    else {
+        insertNonFull(root, rootPage, false, key);
+    }
+    num_keys++;
+}
+
+template <typename T>
+int DiskBTree<T>::getHeight() {
+    if (root == INVALID_PAGE_ID) return 0;
+
+    PageId id = root;
+    int height = 0;
+    while (true) {
+        DiskNodeView<T> node = view(pool.fetchPage(id));
+        height++;
+        bool leaf = node.isLeaf();
+        PageId next = leaf ? INVALID_PAGE_ID : node.child(0);
+        pool.unpinPage(id, false);
+        if (leaf) break;
+        id = next;
+    }
+    return height;
+}
+
+
+template class DiskBTree<int>;
@@ -0,0 +1,269 @@
+#include "fixed_b_tree.h"
+#include <new>
+#include <type_traits>
+
+
+
+// Nodes are over-aligned, which plain new only guarantees from C++17 on,
+// so the allocator is always asked for alignof(Node)
+template <typename T, int Degree>
+typename FixedBTree<T, Degree>::Node* FixedBTree<T, Degree>::allocateNode(bool leaf) {
+    void* memory = allocator->allocate(sizeof(Node), alignof(Node));
+    return new (memory) Node(leaf);
+}
+
+template <typename T, int Degree>
+void FixedBTree<T, Degree>::freeNode(Node* node) {
+    node->~Node();
+    allocator->deallocate(node, sizeof(Node));
+}
+
+template <typename T, int Degree>
+void FixedBTree<T, Degree>::destroy(Node* node) {
+    if (node == nullptr) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) {
+            destroy(node->children[i]);
+        }
+    }
+    freeNode(node);
+}
+
+// Arena and slab nodes go back a block at a time with the allocator
+template <typename T, int Degree>
+FixedBTree<T, Degree>::~FixedBTree() {
+    if (!allocator->releasesInBulk() || !std::is_trivially_destructible<T>::value) {
+        destroy(root);
+    }
+}
+
+
+template <typename T, int Degree>
+bool FixedBTree<T, Degree>::search(T key) const {
+    const Node* node = root;
+    while (node != nullptr) {
+        int i = node->lowerBound(key);
+        if (i < node->num_keys && node->keys[i] == key) {
+            return true;
+        }
+        if (node->is_leaf) {
+            return false;
+        }
+        node = node->children[i];
+    }
+    return false;
+}
+
+
+// Bring in the header and key slots of a node: everything the in-node
+// search touches. The child pointer it then needs is fetched separately.
+template <typename T, int Degree>
+static inline void prefetchKeys(const FixedBtreeNode<T, Degree>* node) {
+    const char* start = reinterpret_cast<const char*>(node);
+    const char* end = reinterpret_cast<const char*>(node->children);
+    for (const char* line = start; line < end; line += CACHE_LINE_SIZE) {
+        __builtin_prefetch(line);
+    }
+}
+
+// Round-robin over group lookup slots. A slot alternates between two
+// stages, each ending with a prefetch and a switch to the next slot:
+//   SEARCH: keys are (hopefully) cached; find i, prefetch &children[i]
+//   FOLLOW: child pointer is cached; load it, prefetch the child's keys
+// By the time a slot comes round again its line has had group-1 other
+// steps' worth of time to arrive.
+template <typename T, int Degree>
+size_t FixedBTree<T, Degree>::searchInterleaved(const T* probes, size_t count,
+                                                std::vector<bool>& found, int group) const {
+    found.assign(count, false);
+    if (root == nullptr || count == 0) {
+        return 0;
+    }
+    if (group < 1) {
+        group = 1;
+    }
+
+    enum Stage { SEARCH, FOLLOW };
+    struct Lookup {
+        const Node* node;          // nullptr once the slot has no more work
+        Node* const* child_slot;   // FOLLOW: pointer to load next
+        size_t probe;
+        Stage stage;
+    };
+
+    std::vector<Lookup> slots(group);
+    size_t next = 0;
+    size_t hits = 0;
+    int active = 0;
+
+    auto start = [&](Lookup& slot) {
+        if (next < count) {
+            slot.node = root;
+            slot.probe = next++;
+            slot.stage = SEARCH;
+            active++;
+        } else {
+            slot.node = nullptr;
+        }
+    };
+
+    prefetchKeys(root);
+    for (Lookup& slot : slots) {
+        start(slot);
+    }
+
+    while (active > 0) {
+        for (Lookup& slot : slots) {
+            if (slot.node == nullptr) {
+                continue;
+            }
+
+            if (slot.stage == FOLLOW) {
+                slot.node = *slot.child_slot;
+                prefetchKeys(slot.node);
+                slot.stage = SEARCH;
+                continue;
+            }
+
+            const Node* node = slot.node;
+            const T& key = probes[slot.probe];
+            int i = node->lowerBound(key);
+            bool hit = i < node->num_keys && node->keys[i] == key;
+            if (hit || node->is_leaf) {
+                if (hit) {
+                    found[slot.probe] = true;
+                    hits++;
+                }
+                active--;
+                start(slot);
+                continue;
+            }
+
+            slot.child_slot = &node->children[i];
+            __builtin_prefetch(slot.child_slot);
+            slot.stage = FOLLOW;
+        }
+    }
+    return hits;
+}
+
+
+// Same as BtreeNode::splitChild, with array copies instead of vector ops
+template <typename T, int Degree>
+void FixedBTree<T, Degree>::splitChild(Node* parent, int index, Node* child) {
+    Node* newNode = allocateNode(child->is_leaf);
+
+    // Copy the last (Degree-1) keys and Degree children to the new node
+    for (int j = 0; j < Degree - 1; j++) {
+        newNode->keys[j] = child->keys[j + Degree];
+        child->keys[j + Degree] = std::numeric_limits<T>::max();
+    }
+    if (!child->is_leaf) {
+        for (int j = 0; j < Degree; j++) {
+            newNode->children[j] = child->children[j + Degree];
+        }
+    }
+    newNode->num_keys = Degree - 1;
+
+    T middleKey = child->keys[Degree - 1];
+    child->keys[Degree - 1] = std::numeric_limits<T>::max();
+    child->num_keys = Degree - 1;
+
+    // Shift the parent's keys/children right to make room
+    for (int j = parent->num_keys; j > index; j--) {
+        parent->children[j + 1] = parent->children[j];
+        parent->keys[j] = parent->keys[j - 1];
+    }
+    parent->children[index + 1] = newNode;
+    parent->keys[index] = middleKey;
+    parent->num_keys++;
+}
+
+template <typename T, int Degree>
+void FixedBTree<T, Degree>::insert(T key) {
+    // Case 1: Tree is empty
+    if (root == nullptr) {
+        root = allocateNode(true);
+        root->keys[0] = key;
+        root->num_keys = 1;
+        return;
+    }
+
+    // Case 2: Root is full - grow the tree by one level
+    if (root->isFull()) {
+        Node* newRoot = allocateNode(false);
+        newRoot->children[0] = root;
+        splitChild(newRoot, 0, root);
+        root = newRoot;
+    }
+
+    // Descend, splitting full children before entering them
+    Node* node = root;
+    while (!node->is_leaf) {
+        int i = node->upperBound(key);
+        if (node->children[i]->isFull()) {
+            splitChild(node, i, node->children[i]);
+            if (node->keys[i] < key) {
+                i++;
+            }
+        }
+        node = node->children[i];
+    }
+
+    // Insert into the leaf after any equal keys
+    int pos = node->upperBound(key);
+    for (int j = node->num_keys; j > pos; j--) {
+        node->keys[j] = node->keys[j - 1];
+    }
+    node->keys[pos] = key;
+    node->num_keys++;
+}
+
+
+// In-order walk of the keys in [lo, hi]; returns false once past hi
+template <typename T, int Degree>
+bool FixedBTree<T, Degree>::scan(Node* node, T lo, T hi, std::vector<T>& out) {
+    for (int i = node->lowerBound(lo); i <= node->num_keys; i++) {
+        if (!node->is_leaf && !scan(node->children[i], lo, hi, out)) {
+            return false;
+        }
+        if (i == node->num_keys) {
+            break;
+        }
+        if (hi < node->keys[i]) {
+            return false;
+        }
+        out.push_back(node->keys[i]);
+    }
+    return true;
+}
+
+template <typename T, int Degree>
+std::vector<T> FixedBTree<T, Degree>::rangeScan(T lo, T hi) {
+    std::vector<T> result;
+    if (root != nullptr) {
+        scan(root, lo, hi, result);
+    }
+    return result;
+}
+
+template <typename T, int Degree>
+int FixedBTree<T, Degree>::getHeight() const {
+    int height = 0;
+    const Node* node = root;
+    while (node != nullptr) {
+        height++;
+        node = node->is_leaf ? nullptr : node->children[0];
+    }
+    return height;
+}
+
+
+// Degrees used by the benchmarks
+template class FixedBTree<int, 4>;
+template class FixedBTree<int, 8>;
+template class FixedBTree<int, 16>;
+template class FixedBTree<int, 32>;
+template class FixedBTree<int, 64>;
+template class FixedBTree<int, 100>;
+template class FixedBTree<int, 128>;
@@ -0,0 +1,304 @@
+#include "frozen_b_tree.h"
+#include "checksum.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+
+
+static std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+// Sequential writer for the node area: buffers nodes into large writes
+// and checksums them on the way out
+class FrozenFileWriter {
+private:
+    int fd;
+    std::string path;
+    std::vector<char> buffer;
+    size_t used;
+
+public:
+    uint32_t crc;
+    uint64_t offset;   // File offset of the next byte written
+
+    FrozenFileWriter(int file, const std::string& filename, uint64_t start)
+        : fd(file), path(filename), buffer(1 << 20), used(0), crc(0), offset(start) {}
+
+    void append(const char* data, size_t length) {
+        if (used + length > buffer.size()) {
+            flush();
+        }
+        std::memcpy(buffer.data() + used, data, length);
+        used += length;
+        crc = crc32(data, length, crc);
+        offset += length;
+    }
+
+    void flush() {
+        size_t done = 0;
+        while (done < used) {
+            ssize_t n = ::write(fd, buffer.data() + done, used - done);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw ioError("Cannot write frozen tree", path);
+            }
+            done += static_cast<size_t>(n);
+        }
+        used = 0;
+    }
+};
+
+// Bottom-up: one pass over the keys writes the leaves, then each level is
+// built from the first keys and offsets of the one below until a single
+// node is left
+template <typename T>
+void FrozenBTree<T>::write(const std::string& path, const std::vector<T>& sortedKeys, size_t nodeBytes) {
+    if (nodeBytes < sizeof(FrozenTreeHeader) || nodeBytes % sizeof(uint64_t) != 0 ||
+        internalCapacity(nodeBytes) < 1) {
+        throw std::runtime_error("FrozenBTree node size must hold the header and at least one key");
+    }
+    if (!std::is_sorted(sortedKeys.begin(), sortedKeys.end())) {
+        throw std::runtime_error("FrozenBTree::write needs sorted keys");
+    }
+
+    std::string tmpPath = path + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw ioError("Cannot create frozen tree", tmpPath);
+    }
+
+    FrozenTreeHeader header;
+    std::memset(&header, 0, sizeof(header));
+
+    try {
+        // Header page placeholder; the real header goes in once the CRC is known
+        std::vector<char> page(nodeBytes, 0);
+        FrozenFileWriter writer(fd, tmpPath, 0);
+        writer.append(page.data(), nodeBytes);
+        writer.crc = 0;
+
+        std::vector<T> firsts;          // First key of each node of the current level
+        std::vector<uint64_t> offsets;  // And its offset
+        size_t perLeaf = leafCapacity(nodeBytes);
+
+        for (size_t i = 0; i < sortedKeys.size(); i += perLeaf) {
+            size_t count = std::min(perLeaf, sortedKeys.size() - i);
+            std::fill(page.begin(), page.end(), 0);
+            FrozenNodeHeader nodeHeader = {static_cast<uint32_t>(count), 0};
+            std::memcpy(page.data(), &nodeHeader, sizeof(nodeHeader));
+            std::memcpy(page.data() + sizeof(nodeHeader), &sortedKeys[i], count * sizeof(T));
+
+            firsts.push_back(sortedKeys[i]);
+            offsets.push_back(writer.offset);
+            writer.append(page.data(), nodeBytes);
+        }
+        header.num_leaves = offsets.size();
+        header.height = offsets.empty() ? 0 : 1;
+
+        // Children are spread evenly over a level's nodes, so no node is
+        // left with a single child
+        size_t maxChildren = internalCapacity(nodeBytes) + 1;
+        while (offsets.size() > 1) {
+            size_t nodes = (offsets.size() + maxChildren - 1) / maxChildren;
+            std::vector<T> levelFirsts;
+            std::vector<uint64_t> levelOffsets;
+
+            size_t child = 0;
+            for (size_t n = 0; n < nodes; n++) {
+                size_t children = offsets.size() / nodes + (n < offsets.size() % nodes ? 1 : 0);
+                size_t count = children - 1;
+
+                std::fill(page.begin(), page.end(), 0);
+                FrozenNodeHeader nodeHeader = {static_cast<uint32_t>(count), header.height};
+                std::memcpy(page.data(), &nodeHeader, sizeof(nodeHeader));
+                char* keyArea = page.data() + sizeof(nodeHeader);
+                std::memcpy(keyArea, &firsts[child + 1], count * sizeof(T));
+                std::memcpy(keyArea + count * sizeof(T), &offsets[child], children * sizeof(uint64_t));
+
+                levelFirsts.push_back(firsts[child]);
+                levelOffsets.push_back(writer.offset);
+                writer.append(page.data(), nodeBytes);
+                child += children;
+            }
+
+            firsts.swap(levelFirsts);
+            offsets.swap(levelOffsets);
+            header.height++;
+        }
+        writer.flush();
+
+        header.magic = FROZEN_BTREE_MAGIC;
+        header.version = FROZEN_BTREE_VERSION;
+        header.key_size = sizeof(T);
+        header.node_bytes = static_cast<uint32_t>(nodeBytes);
+        header.num_keys = sortedKeys.size();
+        header.root_offset = offsets.empty() ? 0 : offsets[0];
+        header.file_bytes = writer.offset;
+        header.body_crc = writer.crc;
+        header.header_crc = crc32(&header, sizeof(header));
+
+        if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+            throw ioError("Cannot write frozen tree header", tmpPath);
+        }
+        if (::fsync(fd) != 0) {
+            throw ioError("fsync failed for", tmpPath);
+        }
+    } catch (...) {
+        ::close(fd);
+        std::remove(tmpPath.c_str());
+        throw;
+    }
+
+    ::close(fd);
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw ioError("Cannot rename frozen tree to", path);
+    }
+}
+
+template <typename T>
+FrozenBTree<T>::FrozenBTree(const std::string& filename)
+    : path(filename), fd(-1), base(nullptr), mapped_bytes(0) {
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw ioError("Cannot open frozen tree", filename);
+    }
+
+    auto fail = [&](const std::string& why) {
+        if (base != nullptr) {
+            ::munmap(const_cast<char*>(base), mapped_bytes);
+        }
+        ::close(fd);
+        return std::runtime_error("Invalid frozen tree '" + filename + "': " + why);
+    };
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw ioError("Cannot stat frozen tree", filename);
+    }
+    if (static_cast<size_t>(st.st_size) < sizeof(FrozenTreeHeader)) {
+        throw fail("file too small");
+    }
+
+    mapped_bytes = static_cast<size_t>(st.st_size);
+    void* memory = ::mmap(nullptr, mapped_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        ::close(fd);
+        throw ioError("Cannot map frozen tree", filename);
+    }
+    base = static_cast<const char*>(memory);
+
+    std::memcpy(&header, base, sizeof(header));
+    FrozenTreeHeader unsummed = header;
+    unsummed.header_crc = 0;
+    if (header.magic != FROZEN_BTREE_MAGIC) {
+        throw fail("bad magic number");
+    }
+    if (header.version != FROZEN_BTREE_VERSION) {
+        throw fail("unsupported version " + std::to_string(header.version));
+    }
+    if (crc32(&unsummed, sizeof(unsummed)) != header.header_crc) {
+        throw fail("header checksum mismatch");
+    }
+    if (header.key_size != sizeof(T)) {
+        throw fail("written with " + std::to_string(header.key_size) + "-byte keys");
+    }
+    if (header.file_bytes != mapped_bytes || header.node_bytes < sizeof(FrozenTreeHeader) ||
+        header.root_offset % header.node_bytes != 0 || header.root_offset >= header.file_bytes) {
+        throw fail("truncated or inconsistent layout");
+    }
+}
+
+template <typename T>
+FrozenBTree<T>::~FrozenBTree() {
+    ::munmap(const_cast<char*>(base), mapped_bytes);
+    ::close(fd);
+}
+
+template <typename T>
+uint64_t FrozenBTree<T>::child(const FrozenNodeHeader* n, size_t i) const {
+    uint64_t offset;
+    std::memcpy(&offset, reinterpret_cast<const char*>(keys(n) + n->num_keys) + i * sizeof(uint64_t),
+                sizeof(offset));
+    return offset;
+}
+
+// Leaf offset and position of the first key >= key, or 0 when every key
+// is smaller. Child i holds keys up to the first key of child i + 1, so
+// the first child whose separator is >= key is where the run of keys
+// >= key starts (possibly at the very end of it).
+template <typename T>
+uint64_t FrozenBTree<T>::lowerBoundLeaf(T key, size_t& pos) const {
+    if (header.root_offset == 0) {
+        return 0;
+    }
+
+    uint64_t offset = header.root_offset;
+    const FrozenNodeHeader* n = node(offset);
+    while (n->level > 0) {
+        size_t i = std::lower_bound(keys(n), keys(n) + n->num_keys, key) - keys(n);
+        offset = child(n, i);
+        n = node(offset);
+    }
+
+    pos = std::lower_bound(keys(n), keys(n) + n->num_keys, key) - keys(n);
+    if (pos == n->num_keys) {
+        offset += header.node_bytes;
+        pos = 0;
+        if (offset > header.num_leaves * header.node_bytes) {
+            return 0;
+        }
+    }
+    return offset;
+}
+
+template <typename T>
+bool FrozenBTree<T>::search(T key) const {
+    size_t pos;
+    uint64_t offset = lowerBoundLeaf(key, pos);
+    return offset != 0 && !(key < keys(node(offset))[pos]);
+}
+
+// Leaves are contiguous, so the scan is a sequential walk over the file
+template <typename T>
+std::vector<T> FrozenBTree<T>::rangeScan(T lo, T hi) const {
+    std::vector<T> result;
+    size_t pos;
+    uint64_t offset = lowerBoundLeaf(lo, pos);
+    if (offset == 0) {
+        return result;
+    }
+
+    uint64_t leafEnd = (header.num_leaves + 1) * header.node_bytes;
+    for (; offset < leafEnd; offset += header.node_bytes, pos = 0) {
+        const FrozenNodeHeader* leaf = node(offset);
+        for (; pos < leaf->num_keys; pos++) {
+            T key = keys(leaf)[pos];
+            if (hi < key) {
+                return result;
+            }
+            result.push_back(key);
+        }
+    }
+    return result;
+}
+
+template <typename T>
+bool FrozenBTree<T>::verify() const {
+    return crc32(base + header.node_bytes, header.file_bytes - header.node_bytes) == header.body_crc;
+}
+
+
+template class FrozenBTree<int>;
@@ -0,0 +1,25 @@
+#include "instrumentation.h"
+
+
+
+#ifdef TREE_INSTRUMENTATION
+
+thread_local TreeOpCounters tree_op_counters = {0, 0, 0, 0};
+
+void resetTreeOpCounters() {
+    tree_op_counters = TreeOpCounters{0, 0, 0, 0};
+}
+
+TreeOpCounters readTreeOpCounters() {
+    return tree_op_counters;
+}
+
+#else
+
+void resetTreeOpCounters() {}
+
+TreeOpCounters readTreeOpCounters() {
+    return TreeOpCounters{0, 0, 0, 0};
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+
+// 2 * SUB_BUCKETS exact buckets, then SUB_BUCKETS per power of two up to 2^64
+LatencyHistogram::LatencyHistogram()
+    : counts((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS, 0), total(0),
+      min_value(std::numeric_limits<uint64_t>::max()), max_value(0), sum(0.0) {}
+
+uint64_t LatencyHistogram::bucketHighest(size_t index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t sub = index - shift * SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    sum += other.sum;
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    sum = 0.0;
+    min_value = std::numeric_limits<uint64_t>::max();
+    max_value = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * total));
+    rank = std::max<uint64_t>(1, std::min(rank, total));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketHighest(i), max_value);
+        }
+    }
+    return max_value;
+}
@@ -0,0 +1,322 @@
+#include "lsm_tree.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+
+std::string compactionPolicyName(CompactionPolicy policy) {
+    switch (policy) {
+        case CompactionPolicy::LEVELED: return "Leveled";
+        case CompactionPolicy::TIERED:  return "Tiered";
+    }
+    return "Unknown";
+}
+
+// Keeps the run files of trees alive at the same time apart
+static std::atomic<unsigned> lsm_instances(0);
+
+template <typename T>
+LSMTree<T>::LSMTree(const LSMConfig& treeConfig)
+    : config(treeConfig), next_run_id(0),
+      memtable(new RBTree<T>(NodeAllocatorKind::ARENA)), levels(1),
+      inserts(0), pages_written(0), lookup_reads(0), compaction_reads(0), compactions(0) {
+    if (config.page_size < sizeof(uint32_t) + sizeof(T)) {
+        throw std::runtime_error("LSM block size too small for a key");
+    }
+    if (config.memtable_keys == 0 || config.size_ratio < 2 || config.l0_runs == 0) {
+        throw std::runtime_error("LSM memtable size, size ratio and level-0 runs must be positive");
+    }
+    file_prefix = config.directory + "/lsm_" + std::to_string(lsm_instances++) + "_";
+}
+
+template <typename T>
+LSMTree<T>::~LSMTree() {
+    for (auto& level : levels) {
+        for (RunPtr& run : level) {
+            removeRun(run);
+        }
+    }
+}
+
+template <typename T>
+void LSMTree<T>::removeRun(RunPtr& run) {
+    std::string path = run->file->getPath();
+    run.reset();
+    std::remove(path.c_str());
+}
+
+template <typename T>
+size_t LSMTree<T>::getRuns() const {
+    size_t runs = 0;
+    for (const auto& level : levels) {
+        runs += level.size();
+    }
+    return runs;
+}
+
+template <typename T>
+size_t LSMTree<T>::getDiskKeys() const {
+    size_t keys = 0;
+    for (const auto& level : levels) {
+        for (const RunPtr& run : level) {
+            keys += run->num_keys;
+        }
+    }
+    return keys;
+}
+
+
+// === Run files ===
+
+template <typename T>
+void LSMTree<T>::readBlock(const LSMRun<T>& run, size_t block, std::vector<T>& keys, long long& counter) {
+    std::vector<char> page(config.page_size);
+    run.file->readPage(static_cast<PageId>(block), page.data());
+    counter++;
+
+    uint32_t count;
+    std::memcpy(&count, page.data(), sizeof(count));
+    keys.resize(count);
+    std::memcpy(keys.data(), page.data() + sizeof(count), count * sizeof(T));
+}
+
+// k-way merge of the input runs (and the memtable's sorted keys, on a
+// flush) into a new run, written block by block. Equal keys are written
+// once. k is at most a level's worth of runs, so the smallest head is
+// found with a plain scan.
+template <typename T>
+typename LSMTree<T>::RunPtr LSMTree<T>::writeRun(const std::vector<const LSMRun<T>*>& inputs,
+                                                 const std::vector<T>* memtableKeys) {
+    struct Cursor {
+        const LSMRun<T>* run;   // Null for the memtable
+        size_t block;
+        std::vector<T> keys;
+        size_t pos;
+    };
+
+    std::vector<Cursor> cursors;
+    if (memtableKeys != nullptr && !memtableKeys->empty()) {
+        cursors.push_back(Cursor{nullptr, 0, *memtableKeys, 0});
+    }
+    for (const LSMRun<T>* input : inputs) {
+        Cursor cursor{input, 0, std::vector<T>(), 0};
+        readBlock(*input, 0, cursor.keys, compaction_reads);
+        cursors.push_back(cursor);
+    }
+
+    RunPtr run(new LSMRun<T>());
+    std::string path = file_prefix + std::to_string(next_run_id++) + ".run";
+    run->file.reset(new PageFile(path, config.page_size, true));
+    run->num_keys = 0;
+
+    std::vector<char> page(config.page_size);
+    uint32_t inBlock = 0;
+    size_t capacity = keysPerBlock();
+
+    while (!cursors.empty()) {
+        size_t smallest = 0;
+        for (size_t i = 1; i < cursors.size(); i++) {
+            if (cursors[i].keys[cursors[i].pos] < cursors[smallest].keys[cursors[smallest].pos]) {
+                smallest = i;
+            }
+        }
+        Cursor& cursor = cursors[smallest];
+        T key = cursor.keys[cursor.pos];
+
+        if (run->num_keys == 0 || run->max_key < key) {
+            if (inBlock == 0) {
+                run->fences.push_back(key);
+            }
+            std::memcpy(page.data() + sizeof(uint32_t) + inBlock * sizeof(T), &key, sizeof(T));
+            inBlock++;
+            if (run->num_keys == 0) {
+                run->min_key = key;
+            }
+            run->max_key = key;
+            run->num_keys++;
+
+            if (inBlock == capacity) {
+                std::memcpy(page.data(), &inBlock, sizeof(inBlock));
+                run->file->writePage(run->file->allocatePage(), page.data());
+                pages_written++;
+                inBlock = 0;
+            }
+        }
+
+        // Advance, pulling the next block of a run when this one is used up
+        if (++cursor.pos == cursor.keys.size()) {
+            cursor.pos = 0;
+            if (cursor.run != nullptr && ++cursor.block < cursor.run->fences.size()) {
+                readBlock(*cursor.run, cursor.block, cursor.keys, compaction_reads);
+            } else {
+                cursors.erase(cursors.begin() + smallest);
+            }
+        }
+    }
+
+    if (inBlock > 0) {
+        std::memcpy(page.data(), &inBlock, sizeof(inBlock));
+        run->file->writePage(run->file->allocatePage(), page.data());
+        pages_written++;
+    }
+    return run;
+}
+
+
+// === Flush and compaction ===
+
+// LEVELED budget of level i >= 1: memtable_keys * size_ratio^i keys
+template <typename T>
+size_t LSMTree<T>::levelCapacity(size_t level) const {
+    size_t capacity = config.memtable_keys;
+    for (size_t i = 0; i < level; i++) {
+        capacity *= config.size_ratio;
+    }
+    return capacity;
+}
+
+template <typename T>
+bool LSMTree<T>::levelFull(size_t level) const {
+    if (config.policy == CompactionPolicy::TIERED) {
+        return levels[level].size() >= config.size_ratio;
+    }
+    if (level == 0) {
+        return levels[0].size() >= config.l0_runs;
+    }
+    return !levels[level].empty() && levels[level][0]->num_keys > levelCapacity(level);
+}
+
+// Merge level into level + 1. LEVELED rewrites the next level's run as
+// part of the merge (that rewrite is where its write amplification comes
+// from); TIERED just adds one more run there.
+template <typename T>
+void LSMTree<T>::compact(size_t level) {
+    if (level + 1 == levels.size()) {
+        levels.emplace_back();
+    }
+
+    std::vector<const LSMRun<T>*> inputs;
+    for (const RunPtr& run : levels[level]) {
+        inputs.push_back(run.get());
+    }
+    if (config.policy == CompactionPolicy::LEVELED) {
+        for (const RunPtr& run : levels[level + 1]) {
+            inputs.push_back(run.get());
+        }
+    }
+
+    RunPtr merged = writeRun(inputs, nullptr);
+
+    for (RunPtr& run : levels[level]) {
+        removeRun(run);
+    }
+    levels[level].clear();
+    if (config.policy == CompactionPolicy::LEVELED) {
+        for (RunPtr& run : levels[level + 1]) {
+            removeRun(run);
+        }
+        levels[level + 1].clear();
+    }
+    levels[level + 1].push_back(std::move(merged));
+    compactions++;
+}
+
+template <typename T>
+void LSMTree<T>::flushMemtable() {
+    if (memtable->size() == 0) {
+        return;
+    }
+
+    std::vector<T> keys = memtable->rangeScan(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+    levels[0].push_back(writeRun(std::vector<const LSMRun<T>*>(), &keys));
+    memtable.reset(new RBTree<T>(NodeAllocatorKind::ARENA));
+
+    // A merge can fill the next level in turn
+    for (size_t level = 0; level < levels.size(); level++) {
+        if (levelFull(level)) {
+            compact(level);
+        }
+    }
+}
+
+template <typename T>
+void LSMTree<T>::flush() {
+    flushMemtable();
+}
+
+template <typename T>
+void LSMTree<T>::insert(T key) {
+    memtable->insert(key);
+    inserts++;
+    if (memtable->size() >= config.memtable_keys) {
+        flushMemtable();
+    }
+}
+
+
+// === Lookups ===
+
+// Fence pointers pick the only block that can hold key
+template <typename T>
+bool LSMTree<T>::searchRun(const LSMRun<T>& run, T key) {
+    if (key < run.min_key || run.max_key < key) {
+        return false;
+    }
+    size_t block = std::upper_bound(run.fences.begin(), run.fences.end(), key) - run.fences.begin() - 1;
+
+    std::vector<T> keys;
+    readBlock(run, block, keys, lookup_reads);
+    return std::binary_search(keys.begin(), keys.end(), key);
+}
+
+template <typename T>
+bool LSMTree<T>::search(T key) {
+    if (memtable->search(key)) {
+        return true;
+    }
+    for (const auto& level : levels) {
+        for (auto it = level.rbegin(); it != level.rend(); ++it) {
+            if (searchRun(**it, key)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Every source contributes its keys in [lo, hi]; the union is sorted and
+// deduplicated at the end
+template <typename T>
+std::vector<T> LSMTree<T>::rangeScan(T lo, T hi) {
+    std::vector<T> result = memtable->rangeScan(lo, hi);
+    std::vector<T> keys;
+
+    for (const auto& level : levels) {
+        for (const RunPtr& run : level) {
+            if (hi < run->min_key || run->max_key < lo) {
+                continue;
+            }
+            size_t block = std::upper_bound(run->fences.begin(), run->fences.end(), lo) - run->fences.begin();
+            block = block == 0 ? 0 : block - 1;
+            for (; block < run->fences.size() && !(hi < run->fences[block]); block++) {
+                readBlock(*run, block, keys, lookup_reads);
+                for (const T& key : keys) {
+                    if (!(key < lo) && !(hi < key)) {
+                        result.push_back(key);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+
+template class LSMTree<int>;
@@ -1,17 +1,18 @@
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <thread>
 #include "../include/benchmark.h"
 #include "../include/b_tree.h"
 #include "../include/bst.h"
+#include "../include/avl_tree.h"
+#include "../include/rb_tree.h"
+#include "../include/b_plus_tree.h"
+#include "../include/fixed_b_tree.h"
 
 using namespace std;
 using namespace chrono;
 
-// Global counters for disk operations (we'll increment these in tree operations)
-int g_disk_reads = 0;
-int g_disk_writes = 0;
-
 void printSectionHeader(const string& title) {
     cout << "\n╔══════════════════════════════════════════════════════════════════╗" << endl;
     cout << "║  " << left << setw(62) << title << "  ║" << endl;
@@ -27,58 +28,68 @@ void printSubHeader(const string& title) {
 
 
 
-template<typename TreeType>
-OperationMetrics benchmarkTree(
-    TreeType& tree,
-    const vector<int>& insertData,
-    const vector<int>& searchData,
-    const string& treeName,
-    bool simulateDisk = false
-) {
-    OperationMetrics metrics = {0};
-    
-    // === INSERT BENCHMARK ===
-    g_disk_reads = 0;
-    g_disk_writes = 0;
-    
-    auto start = high_resolution_clock::now();
-    for (int key : insertData) {
-        tree.insert(key);
-        if (simulateDisk) {
-            g_disk_writes++;
-        }
+void printPhase(const string& label, const TimingSummary& phase, const string& unit) {
+    cout << "  " << left << setw(18) << label << right << fixed << setprecision(1)
+         << setw(12) << phase.median_us << " μs ± " << setw(8)
+         << (phase.ci95_high_us - phase.ci95_low_us) / 2 << " (" << unit << ")" << endl;
+    cout.unsetf(ios::fixed);
+}
+
+// Per-operation tail: splits and rebalancing show up here, not in the totals
+void printLatency(const string& label, const LatencySummary& latency) {
+    cout << "  " << left << setw(18) << label << right << setw(12) << latency.p99_ns
+         << " ns p99 (p50 " << latency.p50_ns << ", p999 " << latency.p999_ns
+         << ", max " << latency.max_ns << ")" << endl;
+}
+
+// Exact access counts per operation (make INSTRUMENT=1)
+void printAccesses(const string& label, const AccessCounts& accesses) {
+    if (accesses.nodes_visited < 0) {
+        return;
     }
-    auto end = high_resolution_clock::now();
-    metrics.insert_time_us = duration_cast<microseconds>(end - start).count();
-    
-    // === SEARCH BENCHMARK ===
-    start = high_resolution_clock::now();
-    for (int key : searchData) {
-        tree.search(key);
-        if (simulateDisk) {
-            g_disk_reads++;
+    cout << "  " << left << setw(18) << label << right << fixed << setprecision(2)
+         << accesses.nodes_visited << " nodes, " << accesses.key_comparisons << " comparisons, "
+         << setprecision(4) << accesses.node_splits << " splits, " << setprecision(1)
+         << accesses.bytes_moved << " bytes moved /op" << endl;
+    cout.unsetf(ios::fixed);
+}
+
+// Hardware events per operation, only the ones that were counted (--perf)
+void printCounters(const string& label, const PhaseCounters& counters) {
+    static const char* units[] = {"cycles", "instr", "L1D miss", "LLC miss", "br miss", "dTLB miss"};
+    string line;
+    for (int e = 0; e < PERF_EVENTS; e++) {
+        if (counters.per_op[e] >= 0) {
+            ostringstream value;
+            value << fixed << setprecision(e < 2 ? 0 : 2) << counters.per_op[e] << " " << units[e];
+            line += (line.empty() ? "" : ", ") + value.str();
         }
     }
-    end = high_resolution_clock::now();
-    metrics.search_time_us = duration_cast<microseconds>(end - start).count();
-    
-    // === RANGE QUERY BENCHMARK (search consecutive keys) ===
-    if (searchData.size() >= 100) {
-        start = high_resolution_clock::now();
-        for (size_t i = 0; i < 100; i++) {
-            tree.search(searchData[i]);
-        }
-        end = high_resolution_clock::now();
-        metrics.range_query_time_us = duration_cast<microseconds>(end - start).count();
+    if (!line.empty()) {
+        cout << "  " << left << setw(18) << label << right << line << " /op" << endl;
     }
-    
-    metrics.disk_reads = g_disk_reads;
-    metrics.disk_writes = g_disk_writes;
-    
-    return metrics;
 }
 
-void runComprehensiveBenchmark(int numElements, TestScenario scenario, const string& scenarioName) {
+// Medians over the measured runs, with the half-width of the 95% CI of the mean
+void printMetrics(const CaseResult& result) {
+    printPhase("Insert time:", result.phase(BenchmarkPhase::INSERT), "all keys");
+    printPhase("Search time:", result.phase(BenchmarkPhase::SEARCH), "all keys");
+    printPhase("Range scan:", result.phase(BenchmarkPhase::RANGE_100), "100 keys");
+    printPhase("Range scan:", result.phase(BenchmarkPhase::RANGE_10K), "10K keys");
+    printPhase("Range scan:", result.phase(BenchmarkPhase::RANGE_FULL), "full tree");
+    printLatency("Insert latency:", result.insert_latency);
+    printLatency("Search latency:", result.search_latency);
+    printAccesses("Insert accesses:", result.accesses[static_cast<int>(BenchmarkPhase::INSERT)]);
+    printAccesses("Search accesses:", result.accesses[static_cast<int>(BenchmarkPhase::SEARCH)]);
+    printCounters("Insert events:", result.counters[static_cast<int>(BenchmarkPhase::INSERT)]);
+    printCounters("Search events:", result.counters[static_cast<int>(BenchmarkPhase::SEARCH)]);
+    cout << "  Tree height:      " << setw(12) << result.tree_height << " levels" << endl;
+    cout << "  Measured runs:    " << setw(12) << result.repetitions << endl;
+}
+
+
+void runComprehensiveBenchmark(BenchmarkHarness& harness, int numElements, TestScenario scenario,
+                               const string& scenarioName) {
     printSectionHeader("Benchmark: " + to_string(numElements) + " elements - " + scenarioName);
     
     // Generate data based on scenario
@@ -104,36 +115,75 @@ void runComprehensiveBenchmark(int numElements, TestScenario scenario, const str
     vector<int> searchData = data; // Search for same keys we inserted
     
     // === B-TREE BENCHMARK ===
-    printSubHeader("🌳 B-Tree (degree=100)");
-    BTree<int> btree(100);
-    auto btree_metrics = benchmarkTree(btree, data, searchData, "B-Tree", false);
+    printSubHeader("🌳 B-Tree (degree=" + to_string(BENCH_BTREE_DEGREE) + ")");
+    CaseResult btree_metrics = harness.runCase("BTree", scenarioName, data);
+    printMetrics(btree_metrics);
     
-    // Calculate B-tree specific metrics
-    btree_metrics.tree_height = calculateBTreeHeight(btree.getRoot());
+    // Sorted input can skip the split-heavy insert path entirely
+    if (scenario == TestScenario::SEQUENTIAL || scenario == TestScenario::REVERSE) {
+        BTree<int> bulkTree(BENCH_BTREE_DEGREE);
+        auto start = high_resolution_clock::now();
+        bulkTree.bulkLoad(data.begin(), data.end());
+        auto end = high_resolution_clock::now();
+        long long bulk_time = duration_cast<microseconds>(end - start).count();
+        cout << "  Bulk load:        " << setw(12) << bulk_time << " μs (vs "
+             << (long long)btree_metrics.phase(BenchmarkPhase::INSERT).median_us << " μs incremental, height "
+             << calculateBTreeHeight(bulkTree.getRoot()) << ")" << endl;
+    }
     
-    cout << "  Insert time:      " << setw(10) << btree_metrics.insert_time_us << " μs" << endl;
-    cout << "  Search time:      " << setw(10) << btree_metrics.search_time_us << " μs" << endl;
-    cout << "  Range query:      " << setw(10) << btree_metrics.range_query_time_us << " μs (100 keys)" << endl;
-    cout << "  Tree height:      " << setw(10) << btree_metrics.tree_height << " levels" << endl;
+    // Same lookups resolved in sorted batches that share their descents
+    {
+        BTree<int> btree(BENCH_BTREE_DEGREE);
+        for (int key : data) {
+            btree.insert(key);
+        }
+        const size_t batchSize = 256;
+        vector<bool> found;
+        size_t visits = 0;
+        auto start = high_resolution_clock::now();
+        for (size_t b = 0; b < searchData.size(); b += batchSize) {
+            size_t count = min(batchSize, searchData.size() - b);
+            visits += btree.searchBatch(searchData.data() + b, count, found);
+        }
+        auto end = high_resolution_clock::now();
+        cout << "  Batch search:     " << setw(12) << duration_cast<microseconds>(end - start).count()
+             << " μs (batches of " << batchSize << ", " << fixed << setprecision(2)
+             << (double)visits / searchData.size() << " node visits/lookup)" << endl;
+        cout.unsetf(ios::fixed);
+    }
+    
+    // === B+TREE BENCHMARK ===
+    printSubHeader("🍃 B+Tree (degree=" + to_string(BENCH_BTREE_DEGREE) + ", linked leaves)");
+    CaseResult bplus_metrics = harness.runCase("BPlusTree", scenarioName, data);
+    printMetrics(bplus_metrics);
+    
+    // === FIXED-LAYOUT B-TREE BENCHMARK ===
+    printSubHeader("🧱 Fixed-layout B-Tree (degree=" + to_string(BENCH_BTREE_DEGREE) + ", " +
+                   to_string(FixedBTree<int, BENCH_BTREE_DEGREE>::nodeBytes()) + "-byte inline nodes)");
+    CaseResult fixed_metrics = harness.runCase("FixedBTree", scenarioName, data);
+    printMetrics(fixed_metrics);
     
     // === BST BENCHMARK ===
     printSubHeader("🌲 Binary Search Tree");
-    BST<int> bst;
-    auto bst_metrics = benchmarkTree(bst, data, searchData, "BST", false);
+    CaseResult bst_metrics = harness.runCase("BST", scenarioName, data);
+    printMetrics(bst_metrics);
     
-    // Calculate BST specific metrics
-    bst_metrics.tree_height = calculateBSTHeight(bst.getRoot());
+    // === BALANCED BINARY TREE BENCHMARKS ===
+    printSubHeader("⚖️  AVL Tree");
+    CaseResult avl_metrics = harness.runCase("AVL", scenarioName, data);
+    printMetrics(avl_metrics);
     
-    cout << "  Insert time:      " << setw(10) << bst_metrics.insert_time_us << " μs" << endl;
-    cout << "  Search time:      " << setw(10) << bst_metrics.search_time_us << " μs" << endl;
-    cout << "  Range query:      " << setw(10) << bst_metrics.range_query_time_us << " μs (100 keys)" << endl;
-    cout << "  Tree height:      " << setw(10) << bst_metrics.tree_height << " levels" << endl;
+    printSubHeader("🔴 Red-Black Tree");
+    CaseResult rb_metrics = harness.runCase("RedBlack", scenarioName, data);
+    printMetrics(rb_metrics);
     
     // === COMPARISON ===
     printSubHeader("📊 Performance Comparison");
     
-    double insert_ratio = (double)bst_metrics.insert_time_us / btree_metrics.insert_time_us;
-    double search_ratio = (double)bst_metrics.search_time_us / btree_metrics.search_time_us;
+    // Ratios of medians, so one noisy run cannot flip a comparison
+    auto median = [](const CaseResult& r, BenchmarkPhase p) { return max(0.001, r.phase(p).median_us); };
+    double insert_ratio = median(bst_metrics, BenchmarkPhase::INSERT) / median(btree_metrics, BenchmarkPhase::INSERT);
+    double search_ratio = median(bst_metrics, BenchmarkPhase::SEARCH) / median(btree_metrics, BenchmarkPhase::SEARCH);
     double height_ratio = (double)bst_metrics.tree_height / btree_metrics.tree_height;
     
     cout << fixed << setprecision(2);
@@ -143,6 +193,24 @@ void runComprehensiveBenchmark(int numElements, TestScenario scenario, const str
          << (search_ratio > 1.0 ? "faster ⚡" : "slower") << " than BST" << endl;
     cout << "  Height:  B-tree is " << height_ratio << "x flatter 📏 than BST" << endl;
     
+    // Balanced binary trees remove BST's worst case; compare against the best of them
+    const CaseResult& balanced = median(avl_metrics, BenchmarkPhase::SEARCH) <= median(rb_metrics, BenchmarkPhase::SEARCH)
+                                 ? avl_metrics : rb_metrics;
+    const char* balanced_name = &balanced == &avl_metrics ? "AVL" : "red-black";
+    double balanced_ratio = median(balanced, BenchmarkPhase::SEARCH) / median(btree_metrics, BenchmarkPhase::SEARCH);
+    cout << "  Search:  B-tree is " << balanced_ratio << "x "
+         << (balanced_ratio > 1.0 ? "faster ⚡" : "slower") << " than " << balanced_name
+         << " tree (height " << balanced.tree_height << ")" << endl;
+    
+    double fixed_ratio = median(btree_metrics, BenchmarkPhase::SEARCH) / median(fixed_metrics, BenchmarkPhase::SEARCH);
+    cout << "  Layout:  fixed nodes are " << fixed_ratio << "x "
+         << (fixed_ratio > 1.0 ? "faster ⚡" : "slower") << " than vector nodes (search)" << endl;
+    
+    double scan_ratio = median(btree_metrics, BenchmarkPhase::RANGE_FULL) /
+                        median(bplus_metrics, BenchmarkPhase::RANGE_FULL);
+    cout << "  Scan:    B+tree is " << scan_ratio << "x "
+         << (scan_ratio > 1.0 ? "faster ⚡" : "slower") << " than B-tree (full scan)" << endl;
+    
     // === DISK I/O SIMULATION ===
     printSubHeader("💾 Simulated Disk I/O (10ms per operation)");
     
@@ -156,7 +224,15 @@ void runComprehensiveBenchmark(int numElements, TestScenario scenario, const str
     cout << "  Speedup on disk:    " << fixed << setprecision(1)
          << (double)bst_disk_time / btree_disk_time << "x faster ⚡⚡⚡" << endl;
 }
-int main() {
+int main(int argc, char* argv[]) {
+    // --perf counts hardware events (cycles, cache and TLB misses) per phase
+    HarnessConfig config;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--perf") {
+            config.perf_counters = true;
+        }
+    }
+    
     cout << "\n";
     cout << "╔════════════════════════════════════════════════════════════════════╗" << endl;
     cout << "║                                                                    ║" << endl;
@@ -174,10 +250,13 @@ int main() {
         {TestScenario::SKEWED, "Skewed Distribution (90-10 rule)"}
     };
     
+    BenchmarkHarness harness(config);
+    registerDefaultEngines(harness);
+    
     for (size_t i = 0; i < sizes.size(); i++) {
         int size = sizes[i];
         for (size_t j = 0; j < scenarios.size(); j++) {
-            runComprehensiveBenchmark(size, scenarios[j].first, scenarios[j].second);
+            runComprehensiveBenchmark(harness, size, scenarios[j].first, scenarios[j].second);
         }
     }
     
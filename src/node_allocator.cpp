@@ -0,0 +1,158 @@
+#include "node_allocator.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+
+
+// Blocks are cache-line aligned so that aligned node types stay aligned
+static const size_t BLOCK_ALIGNMENT = 64;
+
+static char* allocateBlock(size_t bytes, size_t alignment) {
+    void* memory = nullptr;
+    if (posix_memalign(&memory, alignment < BLOCK_ALIGNMENT ? BLOCK_ALIGNMENT : alignment, bytes) != 0) {
+        throw std::bad_alloc();
+    }
+    return static_cast<char*>(memory);
+}
+
+static char* alignUp(char* ptr, size_t alignment) {
+    uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<char*>((value + alignment - 1) & ~(uintptr_t)(alignment - 1));
+}
+
+std::string nodeAllocatorName(NodeAllocatorKind kind) {
+    switch (kind) {
+        case NodeAllocatorKind::HEAP:  return "Heap";
+        case NodeAllocatorKind::ARENA: return "Arena";
+        case NodeAllocatorKind::SLAB:  return "Slab";
+    }
+    return "Unknown";
+}
+
+
+// === HeapNodeAllocator ===
+
+void* HeapNodeAllocator::allocate(size_t bytes, size_t alignment) {
+    void* memory = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        memory = malloc(bytes);
+    } else if (posix_memalign(&memory, alignment, bytes) != 0) {
+        memory = nullptr;
+    }
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    bytes_reserved += bytes;
+    bytes_in_use += bytes;
+    allocations++;
+    return memory;
+}
+
+// malloc and posix_memalign memory are both released with free()
+void HeapNodeAllocator::deallocate(void* ptr, size_t bytes) {
+    free(ptr);
+    bytes_reserved -= bytes;
+    bytes_in_use -= bytes;
+}
+
+
+// === ArenaNodeAllocator ===
+
+ArenaNodeAllocator::ArenaNodeAllocator(size_t blockSize)
+    : block_size(blockSize), cursor(nullptr), limit(nullptr) {}
+
+ArenaNodeAllocator::~ArenaNodeAllocator() {
+    for (char* block : blocks) {
+        free(block);
+    }
+}
+
+void* ArenaNodeAllocator::allocate(size_t bytes, size_t alignment) {
+    char* start = cursor != nullptr ? alignUp(cursor, alignment) : nullptr;
+    if (start == nullptr || start + bytes > limit) {
+        // Oversized requests get a block of their own
+        size_t size = bytes + alignment > block_size ? bytes + alignment : block_size;
+        char* block = allocateBlock(size, alignment);
+        blocks.push_back(block);
+        bytes_reserved += size;
+        limit = block + size;
+        start = alignUp(block, alignment);
+    }
+    cursor = start + bytes;
+    bytes_in_use += bytes;
+    allocations++;
+    return start;
+}
+
+void ArenaNodeAllocator::deallocate(void*, size_t bytes) {
+    bytes_in_use -= bytes;
+}
+
+
+// === SlabNodeAllocator ===
+
+SlabNodeAllocator::SlabNodeAllocator(size_t objectSize, size_t alignment, size_t blockSize)
+    : slot_alignment(alignment < alignof(FreeSlot) ? alignof(FreeSlot) : alignment),
+      cursor(nullptr), limit(nullptr), free_list(nullptr) {
+    size_t size = objectSize < sizeof(FreeSlot) ? sizeof(FreeSlot) : objectSize;
+    slot_size = (size + slot_alignment - 1) / slot_alignment * slot_alignment;
+    slots_per_block = blockSize / slot_size;
+    if (slots_per_block == 0) {
+        slots_per_block = 1;
+    }
+}
+
+SlabNodeAllocator::~SlabNodeAllocator() {
+    for (char* block : blocks) {
+        free(block);
+    }
+}
+
+void* SlabNodeAllocator::allocate(size_t bytes, size_t alignment) {
+    if (bytes > slot_size || alignment > slot_alignment) {
+        throw std::runtime_error("SlabNodeAllocator: request does not fit a slot");
+    }
+
+    void* slot;
+    if (free_list != nullptr) {
+        slot = free_list;
+        free_list = free_list->next;
+    } else {
+        if (cursor == limit) {
+            size_t size = slots_per_block * slot_size;
+            char* block = allocateBlock(size, slot_alignment);
+            blocks.push_back(block);
+            bytes_reserved += size;
+            cursor = block;
+            limit = block + size;
+        }
+        slot = cursor;
+        cursor += slot_size;
+    }
+    bytes_in_use += slot_size;
+    allocations++;
+    return slot;
+}
+
+void SlabNodeAllocator::deallocate(void* ptr, size_t) {
+    FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+    slot->next = free_list;
+    free_list = slot;
+    bytes_in_use -= slot_size;
+}
+
+
+std::unique_ptr<NodeAllocator> makeNodeAllocator(NodeAllocatorKind kind,
+                                                 size_t nodeSize, size_t nodeAlignment) {
+    switch (kind) {
+        case NodeAllocatorKind::ARENA:
+            return std::unique_ptr<NodeAllocator>(new ArenaNodeAllocator());
+        case NodeAllocatorKind::SLAB:
+            return std::unique_ptr<NodeAllocator>(new SlabNodeAllocator(nodeSize, nodeAlignment));
+        case NodeAllocatorKind::HEAP:
+        default:
+            return std::unique_ptr<NodeAllocator>(new HeapNodeAllocator());
+    }
+}
@@ -0,0 +1,146 @@
+#include "node_search.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NODE_SEARCH_X86 1
+#endif
+
+
+
+std::string nodeSearchModeName(NodeSearchMode mode) {
+    switch (mode) {
+        case NodeSearchMode::LINEAR: return "Linear";
+        case NodeSearchMode::BINARY: return "BranchlessBinary";
+        case NodeSearchMode::SIMD:   return "SIMD";
+    }
+    return "Unknown";
+}
+
+
+// Keys are sorted, so the lanes that satisfy the comparison always form a
+// prefix of each vector: popcount(mask) is how many of them to skip, and a
+// partially-set mask means the answer lies inside this vector.
+
+#ifdef NODE_SEARCH_X86
+
+// SSE2 is part of the x86-64 baseline; the attribute only matters on i386
+__attribute__((target("sse2")))
+static size_t lowerBoundSse2(const int* keys, size_t n, int key) {
+    __m128i needle = _mm_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, block)));
+        if (mask != 0xF) {
+            return i + __builtin_popcount(mask);
+        }
+    }
+    return i + lowerBoundLinear(keys + i, n - i, key);
+}
+
+__attribute__((target("sse2")))
+static size_t upperBoundSse2(const int* keys, size_t n, int key) {
+    __m128i needle = _mm_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, needle)));
+        if (mask != 0) {
+            return i + 4 - __builtin_popcount(mask);
+        }
+    }
+    return i + upperBoundLinear(keys + i, n - i, key);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t lowerBoundAvx2(const int* keys, size_t n, int key) {
+    __m256i needle = _mm256_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+        if (mask != 0xFF) {
+            return i + __builtin_popcount(mask);
+        }
+    }
+    return i + lowerBoundLinear(keys + i, n - i, key);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t upperBoundAvx2(const int* keys, size_t n, int key) {
+    __m256i needle = _mm256_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, needle)));
+        if (mask != 0) {
+            return i + 8 - __builtin_popcount(mask);
+        }
+    }
+    return i + upperBoundLinear(keys + i, n - i, key);
+}
+
+#endif
+
+
+static size_t lowerBoundScalar(const int* keys, size_t n, int key) {
+    return lowerBoundLinear(keys, n, key);
+}
+
+static size_t upperBoundScalar(const int* keys, size_t n, int key) {
+    return upperBoundLinear(keys, n, key);
+}
+
+
+// === Runtime dispatch: resolved once at static initialization ===
+
+typedef size_t (*SearchFn)(const int*, size_t, int);
+
+struct SimdDispatch {
+    SearchFn lower;
+    SearchFn upper;
+    const char* isa;
+    size_t lanes;    // Keys compared per vector
+
+    SimdDispatch() {
+#ifdef NODE_SEARCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            lower = lowerBoundAvx2;
+            upper = upperBoundAvx2;
+            isa = "AVX2";
+            lanes = 8;
+            return;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            lower = lowerBoundSse2;
+            upper = upperBoundSse2;
+            isa = "SSE2";
+            lanes = 4;
+            return;
+        }
+#endif
+        lower = lowerBoundScalar;
+        upper = upperBoundScalar;
+        isa = "scalar";
+        lanes = 1;
+    }
+};
+
+static const SimdDispatch dispatch;
+
+size_t lowerBoundSimd(const int* keys, size_t n, int key) {
+    return dispatch.lower(keys, n, key);
+}
+
+size_t upperBoundSimd(const int* keys, size_t n, int key) {
+    return dispatch.upper(keys, n, key);
+}
+
+const char* simdSearchIsa() {
+    return dispatch.isa;
+}
+
+size_t simdSearchLanes() {
+    return dispatch.lanes;
+}
@@ -0,0 +1,127 @@
+#include "page_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+static std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+// A pread/pwrite that moved less than a page. errno only describes the
+// failure when the call returned -1; a short count (EOF, partial write)
+// leaves it stale, so report the byte count instead.
+static std::runtime_error transferError(const std::string& op, PageId id, ssize_t n,
+                                        size_t pageSize, const std::string& path) {
+    if (n < 0) {
+        return ioError("Cannot " + op + " page " + std::to_string(id) + " in", path);
+    }
+    return std::runtime_error("Short " + op + " of page " + std::to_string(id) + " in '" + path +
+                              "': " + std::to_string(n) + " of " + std::to_string(pageSize) + " bytes");
+}
+
+static bool isAligned(const void* buffer) {
+    return reinterpret_cast<uintptr_t>(buffer) % PageFile::IO_ALIGNMENT == 0;
+}
+
+PageFile::PageFile(const std::string& filename, size_t pageSize, bool truncate, bool directIO)
+    : fd(-1), page_size(pageSize), num_pages(0), path(filename), direct(false), bounce(nullptr),
+      page_reads(0), page_writes(0) {
+    int flags = O_RDWR | O_CREAT;
+    if (truncate) {
+        flags |= O_TRUNC;
+    }
+
+    // O_DIRECT transfers must be whole, aligned blocks
+    if (directIO && page_size % IO_ALIGNMENT == 0) {
+        fd = ::open(filename.c_str(), flags | O_DIRECT, 0644);
+        if (fd >= 0) {
+            direct = true;
+        } else if (errno != EINVAL) {
+            throw ioError("Cannot open page file", filename);
+        }
+    }
+    if (fd < 0) {
+        fd = ::open(filename.c_str(), flags, 0644);
+    }
+    if (fd < 0) {
+        throw ioError("Cannot open page file", filename);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw ioError("Cannot stat page file", filename);
+    }
+    num_pages = static_cast<PageId>(st.st_size / page_size);
+
+    if (direct) {
+        void* memory = nullptr;
+        if (::posix_memalign(&memory, IO_ALIGNMENT, page_size) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot allocate direct I/O buffer for '" + filename + "'");
+        }
+        bounce = static_cast<char*>(memory);
+    }
+}
+
+PageFile::~PageFile() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    std::free(bounce);
+}
+
+void PageFile::readPage(PageId id, void* buffer) {
+    off_t offset = static_cast<off_t>(id) * page_size;
+    void* target = (direct && !isAligned(buffer)) ? bounce : buffer;
+    ssize_t n = ::pread(fd, target, page_size, offset);
+    if (n != static_cast<ssize_t>(page_size)) {
+        throw transferError("read", id, n, page_size, path);
+    }
+    if (target != buffer) {
+        std::memcpy(buffer, bounce, page_size);
+    }
+    page_reads++;
+}
+
+void PageFile::writePage(PageId id, const void* buffer) {
+    off_t offset = static_cast<off_t>(id) * page_size;
+    if (direct && !isAligned(buffer)) {
+        std::memcpy(bounce, buffer, page_size);
+        buffer = bounce;
+    }
+    ssize_t n = ::pwrite(fd, buffer, page_size, offset);
+    if (n != static_cast<ssize_t>(page_size)) {
+        throw transferError("write", id, n, page_size, path);
+    }
+    if (id >= num_pages) {
+        num_pages = id + 1;   // Written past the end without allocatePage (log replay)
+    }
+    page_writes++;
+}
+
+PageId PageFile::allocatePage() {
+    // The caller is expected to write the page before reading it back,
+    // so we only reserve the id here instead of paying for a zero-fill write.
+    return num_pages++;
+}
+
+void PageFile::sync() {
+    if (::fdatasync(fd) != 0) {
+        throw ioError("fdatasync failed for", path);
+    }
+}
+
+// Best effort: write back dirty pages so the kernel can drop them all
+void PageFile::dropCache() {
+    if (direct) {
+        return;
+    }
+    sync();
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
@@ -0,0 +1,117 @@
+#include "perf_counters.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+
+
+std::string perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES:        return "Cycles";
+        case PerfEvent::INSTRUCTIONS:  return "Instructions";
+        case PerfEvent::L1D_MISSES:    return "L1DMisses";
+        case PerfEvent::LLC_MISSES:    return "LLCMisses";
+        case PerfEvent::BRANCH_MISSES: return "BranchMisses";
+        case PerfEvent::DTLB_MISSES:   return "DTLBMisses";
+    }
+    return "Unknown";
+}
+
+static int perfEventOpen(perf_event_attr* attr) {
+    // This thread, any CPU, no group
+    return static_cast<int>(::syscall(__NR_perf_event_open, attr, 0, -1, -1, 0));
+}
+
+static uint64_t cacheMissConfig(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+static void eventConfig(PerfEvent event, perf_event_attr& attr) {
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (event) {
+        case PerfEvent::CYCLES:        attr.config = PERF_COUNT_HW_CPU_CYCLES; return;
+        case PerfEvent::INSTRUCTIONS:  attr.config = PERF_COUNT_HW_INSTRUCTIONS; return;
+        case PerfEvent::LLC_MISSES:    attr.config = PERF_COUNT_HW_CACHE_MISSES; return;
+        case PerfEvent::BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; return;
+        case PerfEvent::L1D_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cacheMissConfig(PERF_COUNT_HW_CACHE_L1D);
+            return;
+        case PerfEvent::DTLB_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = cacheMissConfig(PERF_COUNT_HW_CACHE_DTLB);
+            return;
+    }
+}
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < PERF_EVENTS; i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        eventConfig(static_cast<PerfEvent>(i), attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        fds[i] = perfEventOpen(&attr);
+        if (fds[i] < 0 && error.empty()) {
+            error = perfEventName(static_cast<PerfEvent>(i)) + ": " + std::strerror(errno);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int i = 0; i < PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            ::close(fds[i]);
+        }
+    }
+}
+
+bool PerfCounters::available() const {
+    for (int i = 0; i < PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+    for (int i = 0; i < PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            ::ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+PerfReading PerfCounters::stop() {
+    for (int i = 0; i < PERF_EVENTS; i++) {
+        if (fds[i] >= 0) {
+            ::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    PerfReading reading;
+    for (int i = 0; i < PERF_EVENTS; i++) {
+        reading.values[i] = 0.0;
+        reading.valid[i] = false;
+
+        // value, time enabled, time running
+        uint64_t counts[3];
+        if (fds[i] < 0 || ::read(fds[i], counts, sizeof(counts)) != static_cast<ssize_t>(sizeof(counts)) ||
+            counts[2] == 0) {
+            continue;
+        }
+        reading.values[i] = static_cast<double>(counts[0]) * counts[1] / counts[2];
+        reading.valid[i] = true;
+    }
+    return reading;
+}
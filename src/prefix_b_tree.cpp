@@ -0,0 +1,321 @@
+#include "prefix_b_tree.h"
+#include <algorithm>
+#include <cstring>
+
+
+
+static size_t commonPrefixLength(const std::string& a, const std::string& b) {
+    size_t n = std::min(a.size(), b.size());
+    size_t i = 0;
+    while (i < n && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+
+// === PrefixNode ===
+
+std::string PrefixNode::key(size_t i) const {
+    size_t begin = suffixBegin(i);
+    return prefix + suffixes.substr(begin, ends[i] - begin);
+}
+
+std::vector<std::string> PrefixNode::keys() const {
+    std::vector<std::string> result;
+    result.reserve(numKeys());
+    for (size_t i = 0; i < numKeys(); i++) {
+        result.push_back(key(i));
+    }
+    return result;
+}
+
+// Three-way compare of suffix i with a probe tail, like memcmp on the
+// shorter length with the shorter string ordered first
+static int compareSuffix(const PrefixNode& node, size_t i, const char* tail, size_t tailLength) {
+    size_t begin = node.suffixBegin(i);
+    size_t length = node.ends[i] - begin;
+    int c = std::memcmp(node.suffixes.data() + begin, tail, std::min(length, tailLength));
+    if (c != 0) {
+        return c;
+    }
+    return length < tailLength ? -1 : (length > tailLength ? 1 : 0);
+}
+
+bool PrefixNode::keyEquals(size_t i, const std::string& key) const {
+    return key.compare(0, prefix.size(), prefix) == 0 &&
+           compareSuffix(*this, i, key.data() + prefix.size(), key.size() - prefix.size()) == 0;
+}
+
+size_t PrefixNode::lowerBound(const std::string& key) const {
+    int c = key.compare(0, prefix.size(), prefix);
+    if (c != 0) {
+        return c < 0 ? 0 : numKeys();
+    }
+
+    const char* tail = key.data() + prefix.size();
+    size_t tailLength = key.size() - prefix.size();
+    size_t lo = 0;
+    size_t hi = numKeys();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (compareSuffix(*this, mid, tail, tailLength) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+size_t PrefixNode::upperBound(const std::string& key) const {
+    int c = key.compare(0, prefix.size(), prefix);
+    if (c != 0) {
+        return c < 0 ? 0 : numKeys();
+    }
+
+    const char* tail = key.data() + prefix.size();
+    size_t tailLength = key.size() - prefix.size();
+    size_t lo = 0;
+    size_t hi = numKeys();
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (compareSuffix(*this, mid, tail, tailLength) <= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Sorted input, so the prefix shared by the whole range is the one shared
+// by its first and last key
+void PrefixNode::assign(const std::vector<std::string>& keys, size_t first, size_t last, bool compress) {
+    prefix.clear();
+    if (compress && first < last) {
+        prefix = keys[first].substr(0, commonPrefixLength(keys[first], keys[last - 1]));
+    }
+
+    suffixes.clear();
+    ends.clear();
+    for (size_t i = first; i < last; i++) {
+        suffixes.append(keys[i], prefix.size(), std::string::npos);
+        ends.push_back(static_cast<uint32_t>(suffixes.size()));
+    }
+}
+
+// A key outside the current prefix shrinks it, which re-encodes the node
+void PrefixNode::insertKey(size_t pos, const std::string& key, bool compress) {
+    if (compress && (numKeys() == 0 || key.compare(0, prefix.size(), prefix) != 0)) {
+        std::vector<std::string> all = keys();
+        all.insert(all.begin() + pos, key);
+        assign(all, 0, all.size(), true);
+        return;
+    }
+
+    size_t offset = suffixBegin(pos);
+    size_t length = key.size() - prefix.size();
+    suffixes.insert(offset, key, prefix.size(), length);
+    ends.insert(ends.begin() + pos, static_cast<uint32_t>(offset));
+    for (size_t j = pos; j < ends.size(); j++) {
+        ends[j] += static_cast<uint32_t>(length);
+    }
+}
+
+
+// === PrefixBTree ===
+
+PrefixBTree::PrefixBTree(const PrefixBTreeConfig& treeConfig)
+    : root(nullptr), config(treeConfig), num_keys(0) {}
+
+PrefixBTree::~PrefixBTree() {
+    destroy(root);
+}
+
+void PrefixBTree::destroy(PrefixNode* node) {
+    if (node == nullptr) return;
+    for (PrefixNode* child : node->children) {
+        destroy(child);
+    }
+    delete node;
+}
+
+// Shortest s with left < s <= right: right cut one byte past the common
+// prefix. It is a prefix of right, and beats left at the first difference
+// (or extends left, if left is a prefix of right).
+std::string PrefixBTree::separatorBetween(const std::string& left, const std::string& right) const {
+    if (!config.suffix_truncation) {
+        return right;
+    }
+    return right.substr(0, commonPrefixLength(left, right) + 1);
+}
+
+void PrefixBTree::splitNode(PrefixNode* node, std::string& separator, PrefixNode*& sibling) {
+    std::vector<std::string> all = node->keys();
+    size_t n = all.size();
+    size_t mid = n / 2;
+    bool compress = config.prefix_compression;
+    sibling = new PrefixNode(node->is_leaf);
+
+    if (node->is_leaf) {
+        // Any split point near the middle keeps the leaves balanced enough,
+        // so take the one with the shortest separator
+        if (config.suffix_truncation) {
+            size_t window = n / 8;
+            size_t bestLength = separatorBetween(all[mid - 1], all[mid]).size();
+            size_t best = mid;
+            for (size_t m = std::max<size_t>(1, n / 2 - window); m <= std::min(n - 1, n / 2 + window); m++) {
+                size_t length = std::min(commonPrefixLength(all[m - 1], all[m]) + 1, all[m].size());
+                if (length < bestLength) {
+                    bestLength = length;
+                    best = m;
+                }
+            }
+            mid = best;
+        }
+        separator = separatorBetween(all[mid - 1], all[mid]);
+        sibling->assign(all, mid, n, compress);
+        node->assign(all, 0, mid, compress);
+        sibling->next = node->next;
+        node->next = sibling;
+    } else {
+        // The middle separator moves up; it is already as short as it gets
+        separator = all[mid];
+        sibling->assign(all, mid + 1, n, compress);
+        sibling->children.assign(node->children.begin() + mid + 1, node->children.end());
+        node->children.resize(mid + 1);
+        node->assign(all, 0, mid, compress);
+    }
+}
+
+// Bottom-up: a separator can be longer than the key being inserted, so a
+// parent only learns whether it overflows after its child has split.
+// Returns false for a duplicate.
+bool PrefixBTree::insertInto(PrefixNode* node, const std::string& key, std::string& separator,
+                             PrefixNode*& sibling) {
+    sibling = nullptr;
+
+    if (node->is_leaf) {
+        size_t pos = node->lowerBound(key);
+        if (pos < node->numKeys() && node->keyEquals(pos, key)) {
+            return false;
+        }
+        node->insertKey(pos, key, config.prefix_compression);
+    } else {
+        size_t i = node->upperBound(key);
+        std::string childSeparator;
+        PrefixNode* childSibling;
+        if (!insertInto(node->children[i], key, childSeparator, childSibling)) {
+            return false;
+        }
+        if (childSibling != nullptr) {
+            node->insertKey(i, childSeparator, config.prefix_compression);
+            node->children.insert(node->children.begin() + i + 1, childSibling);
+        }
+    }
+
+    size_t minKeysToSplit = node->is_leaf ? 2 : 3;
+    if (node->encodedBytes() > config.node_bytes && node->numKeys() >= minKeysToSplit) {
+        splitNode(node, separator, sibling);
+    }
+    return true;
+}
+
+void PrefixBTree::insert(const std::string& key) {
+    if (root == nullptr) {
+        root = new PrefixNode(true);
+    }
+
+    std::string separator;
+    PrefixNode* sibling;
+    if (!insertInto(root, key, separator, sibling)) {
+        return;
+    }
+    num_keys++;
+
+    // Root split: grow the tree by one level
+    if (sibling != nullptr) {
+        PrefixNode* newRoot = new PrefixNode(false);
+        newRoot->assign(std::vector<std::string>(1, separator), 0, 1, config.prefix_compression);
+        newRoot->children.push_back(root);
+        newRoot->children.push_back(sibling);
+        root = newRoot;
+    }
+}
+
+const PrefixNode* PrefixBTree::findLeaf(const std::string& key) const {
+    const PrefixNode* node = root;
+    while (node != nullptr && !node->is_leaf) {
+        node = node->children[node->upperBound(key)];
+    }
+    return node;
+}
+
+bool PrefixBTree::search(const std::string& key) const {
+    const PrefixNode* leaf = findLeaf(key);
+    if (leaf == nullptr) {
+        return false;
+    }
+    size_t pos = leaf->lowerBound(key);
+    return pos < leaf->numKeys() && leaf->keyEquals(pos, key);
+}
+
+// One descent, then a walk along the leaf chain
+std::vector<std::string> PrefixBTree::rangeScan(const std::string& lo, const std::string& hi) const {
+    std::vector<std::string> result;
+    const PrefixNode* leaf = findLeaf(lo);
+    size_t i = leaf == nullptr ? 0 : leaf->lowerBound(lo);
+
+    for (; leaf != nullptr; leaf = leaf->next, i = 0) {
+        for (; i < leaf->numKeys(); i++) {
+            std::string key = leaf->key(i);
+            if (hi < key) {
+                return result;
+            }
+            result.push_back(key);
+        }
+    }
+    return result;
+}
+
+int PrefixBTree::getHeight() const {
+    int height = 0;
+    for (const PrefixNode* node = root; node != nullptr;
+         node = node->is_leaf ? nullptr : node->children[0]) {
+        height++;
+    }
+    return height;
+}
+
+PrefixTreeStats PrefixBTree::getStats() const {
+    PrefixTreeStats stats = PrefixTreeStats();
+    size_t leafKeys = 0;
+    size_t children = 0;
+
+    std::vector<const PrefixNode*> stack;
+    if (root != nullptr) {
+        stack.push_back(root);
+    }
+    while (!stack.empty()) {
+        const PrefixNode* node = stack.back();
+        stack.pop_back();
+        stats.encoded_bytes += node->encodedBytes();
+
+        if (node->is_leaf) {
+            stats.leaves++;
+            leafKeys += node->numKeys();
+        } else {
+            stats.internal_nodes++;
+            children += node->children.size();
+            stats.separator_bytes += node->numKeys() * node->prefix.size() + node->suffixes.size();
+            for (const PrefixNode* child : node->children) {
+                stack.push_back(child);
+            }
+        }
+    }
+
+    stats.avg_leaf_keys = stats.leaves == 0 ? 0.0 : static_cast<double>(leafKeys) / stats.leaves;
+    stats.avg_fanout = stats.internal_nodes == 0 ? 0.0 : static_cast<double>(children) / stats.internal_nodes;
+    return stats;
+}
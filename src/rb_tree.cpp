@@ -0,0 +1,238 @@
+#include "rb_tree.h"
+#include <new>
+#include <type_traits>
+
+
+
+template <typename T>
+RBTree<T>::RBTree(NodeAllocatorKind allocatorKind)
+    : root(nullptr), num_keys(0),
+      allocator(makeNodeAllocator(allocatorKind, sizeof(RBNode<T>), alignof(RBNode<T>))) {}
+
+template <typename T>
+RBTree<T>::~RBTree() {
+    if (!allocator->releasesInBulk() || !std::is_trivially_destructible<T>::value) {
+        deleteTree();
+    }
+}
+
+template <typename T>
+void RBTree<T>::deleteTree() {
+    std::vector<RBNode<T>*> stack;
+    if (root != nullptr) {
+        stack.push_back(root);
+    }
+    while (!stack.empty()) {
+        RBNode<T>* node = stack.back();
+        stack.pop_back();
+        if (node->left != nullptr) stack.push_back(node->left);
+        if (node->right != nullptr) stack.push_back(node->right);
+        destroyNode(node);
+    }
+    root = nullptr;
+}
+
+template <typename T>
+RBNode<T>* RBTree<T>::createNode(T key, RBNode<T>* parent) {
+    void* memory = allocator->allocate(sizeof(RBNode<T>), alignof(RBNode<T>));
+    return new (memory) RBNode<T>(key, parent);
+}
+
+template <typename T>
+void RBTree<T>::destroyNode(RBNode<T>* node) {
+    node->~RBNode<T>();
+    allocator->deallocate(node, sizeof(RBNode<T>));
+}
+
+
+// === Rotations (relink parent pointers as well as child pointers) ===
+
+template <typename T>
+void RBTree<T>::rotateLeft(RBNode<T>* node) {
+    RBNode<T>* pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left != nullptr) {
+        pivot->left->parent = node;
+    }
+    pivot->parent = node->parent;
+    if (node->parent == nullptr) {
+        root = pivot;
+    } else if (node == node->parent->left) {
+        node->parent->left = pivot;
+    } else {
+        node->parent->right = pivot;
+    }
+    pivot->left = node;
+    node->parent = pivot;
+}
+
+template <typename T>
+void RBTree<T>::rotateRight(RBNode<T>* node) {
+    RBNode<T>* pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right != nullptr) {
+        pivot->right->parent = node;
+    }
+    pivot->parent = node->parent;
+    if (node->parent == nullptr) {
+        root = pivot;
+    } else if (node == node->parent->right) {
+        node->parent->right = pivot;
+    } else {
+        node->parent->left = pivot;
+    }
+    pivot->right = node;
+    node->parent = pivot;
+}
+
+
+template <typename T>
+void RBTree<T>::insert(T key) {
+    RBNode<T>* parent = nullptr;
+    RBNode<T>* node = root;
+    while (node != nullptr) {
+        parent = node;
+        if (key < node->key) {
+            node = node->left;
+        } else if (node->key < key) {
+            node = node->right;
+        } else {
+            return;  // Duplicate
+        }
+    }
+
+    node = createNode(key, parent);
+    num_keys++;
+    if (parent == nullptr) {
+        root = node;
+    } else if (key < parent->key) {
+        parent->left = node;
+    } else {
+        parent->right = node;
+    }
+    insertFixup(node);
+}
+
+// The new red node may have a red parent. A red uncle is fixed by
+// recolouring and moving the problem two levels up; a black uncle by one
+// or two rotations, after which the loop ends.
+template <typename T>
+void RBTree<T>::insertFixup(RBNode<T>* node) {
+    while (node->parent != nullptr && node->parent->color == RBColor::RED) {
+        RBNode<T>* parent = node->parent;
+        RBNode<T>* grandparent = parent->parent;  // Exists: a red node is never the root
+
+        if (parent == grandparent->left) {
+            RBNode<T>* uncle = grandparent->right;
+            if (uncle != nullptr && uncle->color == RBColor::RED) {
+                parent->color = RBColor::BLACK;
+                uncle->color = RBColor::BLACK;
+                grandparent->color = RBColor::RED;
+                node = grandparent;
+            } else {
+                if (node == parent->right) {
+                    node = parent;
+                    rotateLeft(node);
+                    parent = node->parent;
+                }
+                parent->color = RBColor::BLACK;
+                grandparent->color = RBColor::RED;
+                rotateRight(grandparent);
+            }
+        } else {
+            RBNode<T>* uncle = grandparent->left;
+            if (uncle != nullptr && uncle->color == RBColor::RED) {
+                parent->color = RBColor::BLACK;
+                uncle->color = RBColor::BLACK;
+                grandparent->color = RBColor::RED;
+                node = grandparent;
+            } else {
+                if (node == parent->left) {
+                    node = parent;
+                    rotateRight(node);
+                    parent = node->parent;
+                }
+                parent->color = RBColor::BLACK;
+                grandparent->color = RBColor::RED;
+                rotateLeft(grandparent);
+            }
+        }
+    }
+    root->color = RBColor::BLACK;
+}
+
+template <typename T>
+bool RBTree<T>::search(T key) const {
+    const RBNode<T>* node = root;
+    while (node != nullptr) {
+        if (key < node->key) {
+            node = node->left;
+        } else if (node->key < key) {
+            node = node->right;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parent links allow a stackless in-order walk: successor is the leftmost
+// node of the right subtree, or the first ancestor we came up to from the left
+template <typename T>
+std::vector<T> RBTree<T>::rangeScan(T lo, T hi) const {
+    std::vector<T> result;
+
+    // Lower bound: the last node we turned left at
+    RBNode<T>* node = root;
+    RBNode<T>* candidate = nullptr;
+    while (node != nullptr) {
+        if (node->key < lo) {
+            node = node->right;
+        } else {
+            candidate = node;
+            node = node->left;
+        }
+    }
+
+    for (node = candidate; node != nullptr && !(hi < node->key); ) {
+        result.push_back(node->key);
+        if (node->right != nullptr) {
+            node = node->right;
+            while (node->left != nullptr) {
+                node = node->left;
+            }
+        } else {
+            RBNode<T>* child = node;
+            node = node->parent;
+            while (node != nullptr && child == node->right) {
+                child = node;
+                node = node->parent;
+            }
+        }
+    }
+    return result;
+}
+
+// Level-order walk; the longest path can be up to twice the shortest
+template <typename T>
+int RBTree<T>::getHeight() const {
+    int height = 0;
+    std::vector<RBNode<T>*> level;
+    std::vector<RBNode<T>*> next;
+    if (root != nullptr) {
+        level.push_back(root);
+    }
+    while (!level.empty()) {
+        height++;
+        next.clear();
+        for (RBNode<T>* node : level) {
+            if (node->left != nullptr) next.push_back(node->left);
+            if (node->right != nullptr) next.push_back(node->right);
+        }
+        level.swap(next);
+    }
+    return height;
+}
+
+
+template class RBTree<int>;
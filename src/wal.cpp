@@ -0,0 +1,225 @@
+#include "wal.h"
+#include "checksum.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+
+
+// Anything longer is a corrupt length field, not a record
+static const uint32_t MAX_RECORD_PAYLOAD = 1u << 24;
+
+static std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+static uint32_t recordChecksum(const WalRecordHeader& header, const void* payload) {
+    WalRecordHeader copy = header;
+    copy.crc = 0;
+    uint32_t crc = crc32(&copy, sizeof(copy));
+    return crc32(payload, header.length, crc);
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& filename, size_t groupCommit, bool truncate)
+    : fd(-1), path(filename), group_commit(groupCommit == 0 ? 1 : groupCommit),
+      buffered_records(0), next_lsn(1), durable_lsn(0), checkpoint_lsn(0),
+      end_offset(sizeof(WalFileHeader)),
+      records_appended(0), syncs(0), bytes_written(0) {
+    int flags = O_RDWR | O_CREAT;
+    if (truncate) {
+        flags |= O_TRUNC;
+    }
+
+    fd = ::open(filename.c_str(), flags, 0644);
+    if (fd < 0) {
+        throw ioError("Cannot open log file", filename);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw ioError("Cannot stat log file", filename);
+    }
+
+    // New (or never initialised) log: just a header
+    if (st.st_size < static_cast<off_t>(sizeof(WalFileHeader))) {
+        writeHeader();
+        if (::ftruncate(fd, end_offset) != 0 || ::fdatasync(fd) != 0) {
+            ::close(fd);
+            throw ioError("Cannot initialise log file", filename);
+        }
+        return;
+    }
+
+    WalFileHeader header;
+    if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        header.magic != WAL_MAGIC || header.version != WAL_VERSION) {
+        ::close(fd);
+        throw std::runtime_error("Not a log file (bad magic/version): " + filename);
+    }
+    checkpoint_lsn = header.checkpoint_lsn;
+
+    // Walk the valid prefix. The first record sets the LSN sequence, every
+    // later one must continue it.
+    WalRecordHeader record;
+    std::vector<char> payload;
+    off_t offset = sizeof(WalFileHeader);
+    uint64_t lastLsn = 0;
+    while (readRecord(offset, lastLsn == 0 ? 0 : lastLsn + 1, record, payload)) {
+        lastLsn = record.lsn;
+        offset += sizeof(WalRecordHeader) + record.length;
+    }
+
+    // Records the checkpoint already covers are left over from a crash
+    // between writing the header and truncating; drop them with the tail
+    if (lastLsn <= checkpoint_lsn) {
+        offset = sizeof(WalFileHeader);
+        lastLsn = checkpoint_lsn;
+    }
+    end_offset = offset;
+    next_lsn = lastLsn + 1;
+    durable_lsn = lastLsn;
+
+    if (st.st_size != end_offset) {
+        if (::ftruncate(fd, end_offset) != 0 || ::fdatasync(fd) != 0) {
+            ::close(fd);
+            throw ioError("Cannot trim torn tail of log file", filename);
+        }
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    // Destructors must not throw; callers that need the tail durable
+    // call commit() themselves and see the error there.
+    try {
+        commit();
+    } catch (const std::exception&) {
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void WriteAheadLog::writeHeader() {
+    WalFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = WAL_MAGIC;
+    header.version = WAL_VERSION;
+    header.checkpoint_lsn = checkpoint_lsn;
+    if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        throw ioError("Cannot write header of log file", path);
+    }
+}
+
+// Reads and checks the record at offset. expectedLsn = 0 accepts any LSN.
+bool WriteAheadLog::readRecord(off_t offset, uint64_t expectedLsn, WalRecordHeader& header,
+                               std::vector<char>& payload) const {
+    if (::pread(fd, &header, sizeof(header), offset) != static_cast<ssize_t>(sizeof(header))) {
+        return false;
+    }
+    if (header.length > MAX_RECORD_PAYLOAD || (expectedLsn != 0 && header.lsn != expectedLsn)) {
+        return false;
+    }
+    payload.resize(header.length);
+    if (header.length > 0 &&
+        ::pread(fd, payload.data(), header.length, offset + sizeof(header)) !=
+            static_cast<ssize_t>(header.length)) {
+        return false;
+    }
+    return header.crc == recordChecksum(header, payload.data());
+}
+
+
+uint64_t WriteAheadLog::append(WalRecordType type, const void* payload, uint32_t length) {
+    if (length > MAX_RECORD_PAYLOAD) {
+        throw std::runtime_error("Log record of " + std::to_string(length) + " bytes is too large");
+    }
+
+    WalRecordHeader header;
+    header.lsn = next_lsn++;
+    header.type = static_cast<uint32_t>(type);
+    header.length = length;
+    header.crc = 0;
+    header.reserved = 0;
+    header.crc = recordChecksum(header, payload);
+
+    const char* headerBytes = reinterpret_cast<const char*>(&header);
+    buffer.insert(buffer.end(), headerBytes, headerBytes + sizeof(header));
+    buffer.insert(buffer.end(), static_cast<const char*>(payload),
+                  static_cast<const char*>(payload) + length);
+    buffered_records++;
+    records_appended++;
+
+    if (buffered_records >= group_commit) {
+        commit();
+    }
+    return header.lsn;
+}
+
+void WriteAheadLog::commit() {
+    if (buffered_records == 0) {
+        return;
+    }
+
+    size_t done = 0;
+    while (done < buffer.size()) {
+        ssize_t n = ::pwrite(fd, buffer.data() + done, buffer.size() - done, end_offset + done);
+        if (n <= 0) {
+            throw ioError("Short write to log file", path);
+        }
+        done += static_cast<size_t>(n);
+    }
+    if (::fdatasync(fd) != 0) {
+        throw ioError("fdatasync failed for", path);
+    }
+
+    end_offset += buffer.size();
+    bytes_written += buffer.size();
+    syncs++;
+    durable_lsn = next_lsn - 1;
+    buffer.clear();
+    buffered_records = 0;
+}
+
+// Header first, then truncate: if only the header reaches the disk, the
+// stale records are all <= checkpoint_lsn and the next open drops them
+void WriteAheadLog::reset() {
+    buffer.clear();
+    buffered_records = 0;
+    checkpoint_lsn = next_lsn - 1;
+
+    writeHeader();
+    if (::ftruncate(fd, sizeof(WalFileHeader)) != 0) {
+        throw ioError("Cannot truncate log file", path);
+    }
+    if (::fsync(fd) != 0) {
+        throw ioError("fsync failed for", path);
+    }
+
+    end_offset = sizeof(WalFileHeader);
+    durable_lsn = checkpoint_lsn;
+    syncs++;
+}
+
+size_t WriteAheadLog::replay(const std::function<void(const WalRecordHeader&, const char*)>& visit) const {
+    WalRecordHeader header;
+    std::vector<char> payload;
+    size_t visited = 0;
+
+    off_t offset = sizeof(WalFileHeader);
+    while (offset < end_offset) {
+        if (!readRecord(offset, 0, header, payload)) {
+            throw std::runtime_error("Log file changed while replaying: " + path);
+        }
+        if (header.lsn > checkpoint_lsn) {
+            visit(header, payload.data());
+            visited++;
+        }
+        offset += sizeof(WalRecordHeader) + header.length;
+    }
+    return visited;
+}